@@ -0,0 +1,36 @@
+// axisLink.cpp
+#include "axisLink.h"
+
+AxisLink::AxisLink(QObject* parent)
+    : QObject(parent)
+{
+}
+
+void AxisLink::addAxis(QCPAxis* axis)
+{
+    for (const QPointer<QCPAxis>& linked : mAxes) {
+        if (linked) {
+            axis->setRange(linked->range());
+            break;
+        }
+    }
+    mAxes.append(axis);
+    connect(axis, qOverload<const QCPRange&>(&QCPAxis::rangeChanged), this, &AxisLink::followRange);
+}
+
+void AxisLink::followRange(const QCPRange& range)
+{
+    if (mFollowing) {
+        return;
+    }
+    mFollowing = true;
+    const QCPAxis* source = qobject_cast<const QCPAxis*>(sender());
+    for (const QPointer<QCPAxis>& axis : mAxes) {
+        if (!axis || axis == source || axis->range() == range) {
+            continue;
+        }
+        axis->setRange(range);
+        axis->parentPlot()->replot(QCustomPlot::rpQueuedReplot);
+    }
+    mFollowing = false;
+}
\ No newline at end of file
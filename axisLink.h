@@ -0,0 +1,32 @@
+// axisLink.h
+#ifndef AXIS_LINK_H
+#define AXIS_LINK_H
+
+#include <QObject>
+#include <QPointer>
+#include <QVector>
+#include "qcustomplot.h"
+
+// Keeps the ranges of several axes, usually the time axes of different plots, in step: dragging
+// or zooming one moves the others with it. The other plots get a queued replot rather than an
+// immediate one, so however many range changes arrive within one pass of the event loop (mouse
+// moves of a drag, wheel steps, the range being set from code) each plot is redrawn only once.
+class AxisLink : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit AxisLink(QObject* parent = nullptr);
+
+    // The axis takes the range of the axes already linked, if there are any.
+    void addAxis(QCPAxis* axis);
+
+private slots:
+    void followRange(const QCPRange& range);
+
+private:
+    QVector<QPointer<QCPAxis>> mAxes;
+    bool mFollowing = false; // Set while the other axes are being moved, so their signals are ignored
+};
+
+#endif // AXIS_LINK_H
\ No newline at end of file
@@ -0,0 +1,171 @@
+// batchReport.cpp
+#include "batchReport.h"
+#include "mainwindow.h"
+#include <QCoreApplication>
+#include <QDir>
+#include <QFileInfo>
+#include <QProcess>
+#include <QThread>       // Required for QThread::idealThreadCount
+#include <QHash>         // Required for QHash
+#include <algorithm>     // Required for std::sort, std::min_element
+#include <cstring>       // Required for std::strcmp
+#include <iostream>      // Required for std::cerr, std::endl
+#include <memory>        // Required for std::unique_ptr
+
+namespace {
+
+void printUsage()
+{
+    std::cerr << "Usage: --report <output dir> [--pdf] [--jobs N] [--profile <vessel profile>] <csv>..." << std::endl;
+}
+
+} // namespace
+
+bool isReportMode(int argc, char* argv[])
+{
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--report") == 0 || std::strcmp(argv[i], "--report-worker") == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parseReportArguments(const QStringList& arguments, ReportOptions& options)
+{
+    for (int i = 0; i < arguments.size(); ++i) {
+        const QString& argument = arguments[i];
+        if ((argument == "--report" || argument == "--report-worker") && i + 1 < arguments.size()) {
+            options.worker = argument == "--report-worker";
+            options.outputDir = arguments[++i];
+        }
+        else if (argument == "--pdf") {
+            options.pdf = true;
+        }
+        else if (argument == "--jobs" && i + 1 < arguments.size()) {
+            options.jobs = arguments[++i].toInt();
+        }
+        else if (argument == "--profile" && i + 1 < arguments.size()) {
+            options.profileFile = arguments[++i];
+        }
+        else if (argument.startsWith("--")) {
+            std::cerr << "Unknown option " << argument.toStdString() << std::endl;
+            printUsage();
+            return false;
+        }
+        else {
+            options.csvFiles.append(argument);
+        }
+    }
+
+    if (options.outputDir.isEmpty() || options.csvFiles.isEmpty() || options.jobs < 0) {
+        printUsage();
+        return false;
+    }
+    return true;
+}
+
+int runBatchReport(const ReportOptions& options)
+{
+    if (!QDir().mkpath(options.outputDir)) {
+        std::cerr << "Error: Cannot create output directory " << options.outputDir.toStdString() << std::endl;
+        return 1;
+    }
+
+    // Outputs are named after the CSV's base name only: two logs called the same in different
+    // directories would overwrite each other's plots, possibly from two workers at once
+    QHash<QString, QString> filesByOutputName;
+    bool duplicateNames = false;
+    for (const QString& file : options.csvFiles) {
+        const QString outputName = QFileInfo(file).completeBaseName().toLower(); // Case-insensitive file systems
+        const auto existing = filesByOutputName.constFind(outputName);
+        if (existing != filesByOutputName.constEnd()) {
+            std::cerr << "Error: " << existing.value().toStdString() << " and " << file.toStdString()
+                << " would write the same report files; rename one of them" << std::endl;
+            duplicateNames = true;
+        } else {
+            filesByOutputName.insert(outputName, file);
+        }
+    }
+    if (duplicateNames) {
+        return 1;
+    }
+
+    const int available = options.jobs > 0 ? options.jobs : QThread::idealThreadCount();
+    const int workerCount = std::max(1, std::min(available, static_cast<int>(options.csvFiles.size())));
+
+    // Largest files first, each to the worker with the least bytes so far, so workers finish together
+    QStringList files = options.csvFiles;
+    std::sort(files.begin(), files.end(), [](const QString& a, const QString& b) {
+        return QFileInfo(a).size() > QFileInfo(b).size();
+    });
+    std::vector<QStringList> workerFiles(workerCount);
+    std::vector<qint64> workerBytes(workerCount, 0);
+    for (const QString& file : files) {
+        const size_t worker = std::min_element(workerBytes.begin(), workerBytes.end()) - workerBytes.begin();
+        workerFiles[worker].append(file);
+        workerBytes[worker] += QFileInfo(file).size();
+    }
+
+    std::vector<std::unique_ptr<QProcess>> workers;
+    for (const QStringList& filesOfWorker : workerFiles) {
+        QStringList arguments = { "--report-worker", options.outputDir };
+        if (options.pdf) {
+            arguments << "--pdf";
+        }
+        if (!options.profileFile.isEmpty()) {
+            arguments << "--profile" << options.profileFile;
+        }
+        arguments << filesOfWorker;
+
+        workers.emplace_back(new QProcess);
+        workers.back()->setProcessChannelMode(QProcess::ForwardedChannels); // Errors go straight to our stderr
+        workers.back()->start(QCoreApplication::applicationFilePath(), arguments);
+    }
+
+    int failedWorkers = 0;
+    for (const std::unique_ptr<QProcess>& worker : workers) {
+        worker->waitForFinished(-1);
+        // A worker that failed to start still reports a normal exit with code 0
+        if (worker->error() == QProcess::FailedToStart) {
+            std::cerr << "Error: Cannot start report worker: " << worker->errorString().toStdString() << std::endl;
+        }
+        if (worker->error() != QProcess::UnknownError || worker->exitStatus() != QProcess::NormalExit || worker->exitCode() != 0) {
+            ++failedWorkers;
+        }
+    }
+    if (failedWorkers > 0) {
+        std::cerr << "Error: " << failedWorkers << " of " << workers.size() << " report workers failed" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+int runReportWorker(const ReportOptions& options, const VesselProfile& profile,
+    const std::function<PlotDataset(const ColumnTable& rows, const ColumnLayout& layout)>& toDataset)
+{
+    MainWindow plots; // Built once, never shown; every file is drawn with the same plots
+    int failedFiles = 0;
+    for (const QString& csvFile : options.csvFiles) {
+        ColumnLayout layout;
+        if (!resolveColumnLayout(profile, csvFile.toStdString(), layout)) {
+            ++failedFiles;
+            continue;
+        }
+        // One core per worker process: the parallelism comes from running several of them
+        const ColumnTable rows = loadColumnTable(csvFile.toStdString(), layout.schema, profile.delimiter, 1, profile.timestampFormat);
+        if (rows.empty()) {
+            std::cerr << "Error: No data read from " << csvFile.toStdString() << std::endl;
+            ++failedFiles;
+            continue;
+        }
+        plots.setDataset(toDataset(rows, layout));
+
+        const QString basePath = QDir(options.outputDir).filePath(QFileInfo(csvFile).completeBaseName());
+        if (!plots.savePlots(basePath, options.pdf, options.width, options.height)) {
+            std::cerr << "Error: Could not write the plots of " << csvFile.toStdString() << std::endl;
+            ++failedFiles;
+        }
+    }
+    return failedFiles == 0 ? 0 : 1;
+}
\ No newline at end of file
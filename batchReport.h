@@ -0,0 +1,48 @@
+// batchReport.h
+#ifndef BATCH_REPORT_H
+#define BATCH_REPORT_H
+
+#include <QString>
+#include <QStringList>
+#include <functional>
+#include <vector>
+#include "columnCache.h"
+#include "plotDataset.h"
+#include "vesselProfile.h"
+
+// Headless report mode: renders the plots of every given logger CSV to image files, without
+// a display (the offscreen platform plugin is selected automatically).
+//
+//   app --report <output dir> [--pdf] [--jobs N] [--profile <vessel profile>] <csv>...
+//
+// The files are spread over N worker processes (one per core by default), each of which builds the
+// plots once and reuses them for all of its files. Outputs are named <csv base name>_<plot>.png,
+// so the base names of the given files must differ.
+struct ReportOptions
+{
+    QString outputDir;
+    bool pdf = false;
+    int jobs = 0;       // Worker processes; 0 uses one per core
+    int width = 1200;   // Size of every exported plot (pixels, or points for PDF)
+    int height = 800;
+    bool worker = false; // Set in the processes started by runBatchReport (--report-worker)
+    QString profileFile; // Passed on to the workers, which load it themselves
+    QStringList csvFiles;
+};
+
+// Flags that start report mode, checked before the application object exists to pick the platform.
+bool isReportMode(int argc, char* argv[]);
+
+// Parses the arguments following the program name. Returns false, after printing the usage, when
+// they don't make sense.
+bool parseReportArguments(const QStringList& arguments, ReportOptions& options);
+
+// Starts the worker processes for options.csvFiles and waits for them. Returns the exit code.
+int runBatchReport(const ReportOptions& options);
+
+// Renders options.csvFiles one after the other (in a worker process), each parsed with the columns
+// the profile maps in that file. Returns the exit code.
+int runReportWorker(const ReportOptions& options, const VesselProfile& profile,
+    const std::function<PlotDataset(const ColumnTable& rows, const ColumnLayout& layout)>& toDataset);
+
+#endif // BATCH_REPORT_H
\ No newline at end of file
@@ -0,0 +1,402 @@
+// columnCache.cpp
+
+#include "columnCache.h"
+#include "mappedFile.h"
+#include "csvIntoColumns.h"  // Required for skipByteOrderMark
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <system_error>
+#include <algorithm>
+#include <cstdio>    // Required for std::remove
+#include <cstring>   // Required for std::memcmp, std::memcpy
+
+namespace {
+
+const char kCacheMagic[8] = { 'M', 'E', 'E', 'A', 'C', 'O', 'L', 'S' };
+const std::uint32_t kCacheVersion = 1;
+const std::uint32_t kByteOrderMark = 0x01020304; // Reads back differently on a foreign byte order
+const size_t kBlockAlignment = 64;               // Cache line; the mapping itself is page aligned
+const size_t kHashedBytes = size_t(1) << 16;     // Hashed at each end of the source CSV
+
+struct CacheHeader
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byteOrder;
+    std::uint64_t rowCount;
+    std::uint32_t columnCount;
+    std::uint8_t delimiter;
+    std::uint8_t timestampFormat;
+    std::uint16_t reserved;
+    std::uint64_t sourceSize;
+    std::int64_t sourceModified; // Source CSV modification time, in file clock ticks
+    std::uint64_t sourceHash;    // FNV-1a of the first and last 64 KiB of the source CSV
+    std::uint64_t reserved2;
+};
+static_assert(sizeof(CacheHeader) == 64, "CacheHeader is part of the file format");
+
+struct CacheColumn
+{
+    std::uint32_t type;           // ColumnType
+    std::uint32_t reserved;
+    std::uint64_t dataOffset;     // rowCount float64 (Numeric) or int64 (Timestamp) values
+    std::uint64_t errorCount;
+    std::uint64_t badRowsOffset;  // badRowsCount uint64 row indices
+    std::uint64_t badRowsCount;
+};
+static_assert(sizeof(CacheColumn) == 40, "CacheColumn is part of the file format");
+
+// What the cache remembers about the CSV it was built from
+struct SourceStamp
+{
+    std::uint64_t size = 0;
+    std::int64_t modified = 0;
+    std::uint64_t hash = 0;
+};
+
+std::uint64_t fnv1a(const char* data, size_t size, std::uint64_t hash)
+{
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// Size and modification time catch appends and rewrites; the sampled hash catches copies of a
+// different log over the old one. Only the ends are hashed so a check costs microseconds.
+// The source is mapped into file, so a caller parsing it reads exactly the bytes stamped.
+bool stampSource(const std::string& csvFilename, SourceStamp& stamp, MappedFile& file)
+{
+    std::error_code error;
+    auto modified = std::filesystem::last_write_time(csvFilename, error);
+    if (error) {
+        return false;
+    }
+
+    file = MappedFile(csvFilename);
+    if (!file.isOpen()) {
+        return false;
+    }
+
+    stamp.size = file.size();
+    stamp.modified = static_cast<std::int64_t>(modified.time_since_epoch().count());
+    const size_t head = std::min(file.size(), kHashedBytes);
+    const size_t tail = std::min(file.size() - head, kHashedBytes);
+    std::uint64_t hash = fnv1a(file.data(), head, 14695981039346656037ull);
+    stamp.hash = fnv1a(file.data() + file.size() - tail, tail, hash);
+    return true;
+}
+
+size_t alignUp(size_t offset)
+{
+    return (offset + kBlockAlignment - 1) / kBlockAlignment * kBlockAlignment;
+}
+
+void writePadding(std::ofstream& out, size_t& offset)
+{
+    static const char zeros[kBlockAlignment] = {};
+    const size_t aligned = alignUp(offset);
+    out.write(zeros, static_cast<std::streamsize>(aligned - offset));
+    offset = aligned;
+}
+
+bool writeCache(const std::string& csvFilename, const SourceStamp& stamp, const TypedCsv& csv, char delimiter,
+    TimestampFormat timestampFormat)
+{
+    CacheHeader header = {};
+    std::memcpy(header.magic, kCacheMagic, sizeof(kCacheMagic));
+    header.version = kCacheVersion;
+    header.byteOrder = kByteOrderMark;
+    header.rowCount = csv.rowCount;
+    header.columnCount = static_cast<std::uint32_t>(csv.columns.size());
+    header.delimiter = static_cast<std::uint8_t>(delimiter);
+    header.timestampFormat = static_cast<std::uint8_t>(timestampFormat);
+    header.sourceSize = stamp.size;
+    header.sourceModified = stamp.modified;
+    header.sourceHash = stamp.hash;
+
+    // Lay the blocks out first so the descriptors can be written up front
+    std::vector<CacheColumn> descriptors(csv.columns.size());
+    size_t offset = alignUp(sizeof(CacheHeader) + descriptors.size() * sizeof(CacheColumn));
+    for (size_t col_idx = 0; col_idx < csv.columns.size(); ++col_idx) {
+        const TypedColumn& column = csv.columns[col_idx];
+        CacheColumn& descriptor = descriptors[col_idx];
+        descriptor = {};
+        descriptor.type = static_cast<std::uint32_t>(column.type);
+        descriptor.errorCount = column.errorCount;
+        if (column.type != ColumnType::Skip) {
+            descriptor.dataOffset = offset;
+            offset = alignUp(offset + csv.rowCount * 8);
+        }
+        if (!column.badRows.empty()) {
+            descriptor.badRowsOffset = offset;
+            descriptor.badRowsCount = column.badRows.size();
+            offset = alignUp(offset + column.badRows.size() * 8);
+        }
+    }
+
+    const std::string path = ColumnCacheFile::pathFor(csvFilename);
+    const std::string temporaryPath = path + ".tmp";
+    {
+        std::ofstream out(temporaryPath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            return false;
+        }
+
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(descriptors.data()), static_cast<std::streamsize>(descriptors.size() * sizeof(CacheColumn)));
+        size_t written = sizeof(header) + descriptors.size() * sizeof(CacheColumn);
+        writePadding(out, written);
+
+        for (const TypedColumn& column : csv.columns) {
+            if (column.type == ColumnType::Numeric) {
+                out.write(reinterpret_cast<const char*>(column.values.data()), static_cast<std::streamsize>(column.values.size() * 8));
+                written += column.values.size() * 8;
+            }
+            else if (column.type == ColumnType::Timestamp) {
+                out.write(reinterpret_cast<const char*>(column.epochs.data()), static_cast<std::streamsize>(column.epochs.size() * 8));
+                written += column.epochs.size() * 8;
+            }
+            writePadding(out, written);
+
+            if (!column.badRows.empty()) {
+                std::vector<std::uint64_t> rows(column.badRows.begin(), column.badRows.end());
+                out.write(reinterpret_cast<const char*>(rows.data()), static_cast<std::streamsize>(rows.size() * 8));
+                written += rows.size() * 8;
+                writePadding(out, written);
+            }
+        }
+
+        if (!out.good()) {
+            out.close();
+            std::remove(temporaryPath.c_str());
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporaryPath, path, error);
+    if (error) {
+        std::filesystem::remove(temporaryPath, error);
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+ColumnTable ColumnTable::fromTypedCsv(TypedCsv csv, size_t sourceSize)
+{
+    auto owned = std::make_shared<TypedCsv>(std::move(csv));
+
+    ColumnTable table;
+    table.mRowCount = owned->rowCount;
+    table.mSourceSize = sourceSize;
+    table.mColumns.resize(owned->columns.size());
+    for (size_t col_idx = 0; col_idx < owned->columns.size(); ++col_idx) {
+        const TypedColumn& source = owned->columns[col_idx];
+        Column& column = table.mColumns[col_idx];
+        column.type = source.type;
+        column.values = source.values.empty() ? nullptr : source.values.data();
+        column.epochs = source.epochs.empty() ? nullptr : source.epochs.data();
+        column.errorCount = source.errorCount;
+        column.badRows = source.badRows;
+    }
+    table.mOwner = std::move(owned);
+    return table;
+}
+
+std::string ColumnCacheFile::pathFor(const std::string& csvFilename)
+{
+    return csvFilename + ".colcache";
+}
+
+ColumnTable ColumnCacheFile::open(const std::string& csvFilename, const std::vector<ColumnType>& schema, char delimiter,
+    TimestampFormat timestampFormat)
+{
+    SourceStamp stamp;
+    MappedFile source;
+    if (!stampSource(csvFilename, stamp, source)) {
+        return {};
+    }
+
+    auto file = std::make_shared<MappedFile>(pathFor(csvFilename));
+    if (!file->isOpen() || file->size() < sizeof(CacheHeader)) {
+        return {}; // No cache yet
+    }
+
+    CacheHeader header;
+    std::memcpy(&header, file->data(), sizeof(header));
+    if (std::memcmp(header.magic, kCacheMagic, sizeof(kCacheMagic)) != 0 || header.version != kCacheVersion ||
+        header.byteOrder != kByteOrderMark) {
+        return {};
+    }
+
+    // Stale: the CSV changed, or it is being read with a different layout
+    if (header.sourceSize != stamp.size || header.sourceModified != stamp.modified || header.sourceHash != stamp.hash ||
+        header.delimiter != static_cast<std::uint8_t>(delimiter) ||
+        header.timestampFormat != static_cast<std::uint8_t>(timestampFormat) || header.columnCount != schema.size()) {
+        return {};
+    }
+
+    const size_t descriptorsEnd = sizeof(CacheHeader) + schema.size() * sizeof(CacheColumn);
+    if (file->size() < descriptorsEnd) {
+        return {};
+    }
+
+    ColumnTable table;
+    table.mRowCount = static_cast<size_t>(header.rowCount);
+    table.mSourceSize = static_cast<size_t>(header.sourceSize);
+    table.mColumns.resize(schema.size());
+    for (size_t col_idx = 0; col_idx < schema.size(); ++col_idx) {
+        CacheColumn descriptor;
+        std::memcpy(&descriptor, file->data() + sizeof(CacheHeader) + col_idx * sizeof(CacheColumn), sizeof(descriptor));
+        if (descriptor.type != static_cast<std::uint32_t>(schema[col_idx])) {
+            return {};
+        }
+
+        ColumnTable::Column& column = table.mColumns[col_idx];
+        column.type = schema[col_idx];
+        column.errorCount = static_cast<size_t>(descriptor.errorCount);
+        if (column.type != ColumnType::Skip) {
+            if (descriptor.dataOffset % kBlockAlignment != 0 || descriptor.dataOffset + header.rowCount * 8 > file->size()) {
+                return {}; // Truncated or damaged
+            }
+            const char* block = file->data() + descriptor.dataOffset;
+            if (column.type == ColumnType::Numeric) {
+                column.values = reinterpret_cast<const double*>(block);
+            }
+            else {
+                column.epochs = reinterpret_cast<const std::int64_t*>(block);
+            }
+        }
+        if (descriptor.badRowsCount > 0) {
+            if (descriptor.badRowsOffset + descriptor.badRowsCount * 8 > file->size()) {
+                return {};
+            }
+            const std::uint64_t* rows = reinterpret_cast<const std::uint64_t*>(file->data() + descriptor.badRowsOffset);
+            column.badRows.assign(rows, rows + descriptor.badRowsCount);
+        }
+    }
+
+    table.mOwner = std::move(file);
+    return table;
+}
+
+bool ColumnCacheFile::write(const std::string& csvFilename, const TypedCsv& csv, char delimiter, TimestampFormat timestampFormat)
+{
+    SourceStamp stamp;
+    MappedFile source;
+    return stampSource(csvFilename, stamp, source) && writeCache(csvFilename, stamp, csv, delimiter, timestampFormat);
+}
+
+ColumnTable loadColumnTable(const std::string& csvFilename, const std::vector<ColumnType>& schema, char delimiter,
+    size_t threadCount, TimestampFormat timestampFormat)
+{
+    ColumnTable cached = ColumnCacheFile::open(csvFilename, schema, delimiter, timestampFormat);
+    if (!cached.empty()) {
+        return cached;
+    }
+
+    // Parse the very mapping that was stamped: if the logger appends meanwhile, the cache comes
+    // out stale and is simply rebuilt next time, and the appended rows are left to a tail reader
+    SourceStamp stamp;
+    MappedFile source;
+    if (!stampSource(csvFilename, stamp, source)) {
+        return ColumnTable::fromTypedCsv(readCsvTyped(csvFilename, schema, delimiter, threadCount, timestampFormat));
+    }
+
+    std::string_view text = source.view();
+    text.remove_prefix(skipByteOrderMark(text));
+    TypedCsv csv = parseCsvTyped(text, schema, delimiter, threadCount, timestampFormat);
+    if (!csv.empty() && !writeCache(csvFilename, stamp, csv, delimiter, timestampFormat)) {
+        std::cerr << "Warning: Could not write column cache '" << ColumnCacheFile::pathFor(csvFilename) << "'" << std::endl;
+    }
+    return ColumnTable::fromTypedCsv(std::move(csv), source.size());
+}
+
+
+namespace {
+
+// End of the block of whole lines that starts at begin and is about blockBytes long
+size_t blockEnd(std::string_view text, size_t begin, size_t blockBytes)
+{
+    if (blockBytes >= text.size() - begin) {
+        return text.size();
+    }
+    const size_t newline = text.find('\n', begin + blockBytes);
+    return newline == std::string_view::npos ? text.size() : newline + 1;
+}
+
+// Appends a block of parsed rows to the rows parsed before it
+void appendRows(TypedCsv& all, const TypedCsv& rows)
+{
+    if (all.columns.empty()) {
+        all.columns.resize(rows.columns.size());
+        for (size_t col_idx = 0; col_idx < rows.columns.size(); ++col_idx) {
+            all.columns[col_idx].type = rows.columns[col_idx].type;
+        }
+    }
+    for (size_t col_idx = 0; col_idx < rows.columns.size(); ++col_idx) {
+        const TypedColumn& from = rows.columns[col_idx];
+        TypedColumn& to = all.columns[col_idx];
+        to.values.insert(to.values.end(), from.values.begin(), from.values.end());
+        to.epochs.insert(to.epochs.end(), from.epochs.begin(), from.epochs.end());
+        to.errorCount += from.errorCount;
+        for (size_t row : from.badRows) {
+            to.badRows.push_back(all.rowCount + row);
+        }
+    }
+    all.rowCount += rows.rowCount;
+}
+
+} // namespace
+
+size_t loadColumnTableInBlocks(const std::string& csvFilename, const std::vector<ColumnType>& schema, char delimiter,
+    size_t threadCount, TimestampFormat timestampFormat, size_t firstBlockBytes, const ColumnBlockCallback& onBlock)
+{
+    ColumnTable cached = ColumnCacheFile::open(csvFilename, schema, delimiter, timestampFormat);
+    if (!cached.empty()) {
+        return onBlock(cached, 0, cached.sourceSize(), cached.sourceSize()) ? cached.sourceSize() : 0;
+    }
+
+    SourceStamp stamp;
+    MappedFile source;
+    const bool stamped = stampSource(csvFilename, stamp, source);
+    if (!stamped) {
+        // No cache can be written without a stamp, but the rows are still parsed from one mapping,
+        // so the bytes returned are exactly those handed over (follow mode continues after them)
+        source = MappedFile(csvFilename);
+        if (!source.isOpen()) {
+            return 0;
+        }
+    }
+
+    std::string_view text = source.view();
+    const size_t bom = skipByteOrderMark(text);
+    text.remove_prefix(bom);
+
+    // Blocks grow geometrically so the number of blocks, and the caller's work per block, stay small
+    const size_t maxBlockBytes = std::max<size_t>(firstBlockBytes, 1) * 64;
+    size_t block_bytes = std::max<size_t>(firstBlockBytes, 1);
+    TypedCsv all; // For the cache, written once the whole file has been read
+    for (size_t begin = 0; begin < text.size();) {
+        const size_t end = blockEnd(text, begin, block_bytes);
+        TypedCsv rows = parseCsvTyped(text.substr(begin, end - begin), schema, delimiter, threadCount, timestampFormat);
+        const size_t first_row = all.rowCount;
+        appendRows(all, rows);
+        const ColumnTable table = ColumnTable::fromTypedCsv(std::move(rows), bom + end);
+        if (!table.empty() && !onBlock(table, first_row, bom + end, source.size())) {
+            return 0;
+        }
+        begin = end;
+        block_bytes = std::min(block_bytes * 2, maxBlockBytes);
+    }
+
+    if (stamped && !all.empty() && !writeCache(csvFilename, stamp, all, delimiter, timestampFormat)) {
+        std::cerr << "Warning: Could not write column cache '" << ColumnCacheFile::pathFor(csvFilename) << "'" << std::endl;
+    }
+    return source.size();
+}
\ No newline at end of file
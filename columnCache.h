@@ -0,0 +1,88 @@
+// columnCache.h
+#ifndef COLUMN_CACHE_H
+#define COLUMN_CACHE_H
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <cstdint>
+#include <functional>
+#include "csvToTypedColumns.h"
+
+// Read-only typed columns, either parsed from a CSV or memory-mapped from its binary cache file.
+// The column pointers stay valid for as long as the table (or a copy of it) lives.
+class ColumnTable
+{
+public:
+    ColumnTable() = default;
+
+    // Takes ownership of freshly parsed columns, read from the first sourceSize bytes of the CSV.
+    static ColumnTable fromTypedCsv(TypedCsv csv, size_t sourceSize = 0);
+
+    bool empty() const { return mRowCount == 0; }
+    size_t rowCount() const { return mRowCount; }
+    size_t columnCount() const { return mColumns.size(); }
+    size_t sourceSize() const { return mSourceSize; } // CSV bytes covered; rows appended later start there
+
+    ColumnType type(size_t column) const { return mColumns[column].type; }
+    const double* values(size_t column) const { return mColumns[column].values; }         // Numeric columns
+    const std::int64_t* epochs(size_t column) const { return mColumns[column].epochs; }   // Timestamp columns
+    size_t errorCount(size_t column) const { return mColumns[column].errorCount; }
+    const std::vector<size_t>& badRows(size_t column) const { return mColumns[column].badRows; }
+
+private:
+    friend class ColumnCacheFile;
+
+    struct Column
+    {
+        ColumnType type = ColumnType::Skip;
+        const double* values = nullptr;
+        const std::int64_t* epochs = nullptr;
+        size_t errorCount = 0;
+        std::vector<size_t> badRows;
+    };
+
+    std::shared_ptr<const void> mOwner; // TypedCsv or MappedFile backing the pointers
+    std::vector<Column> mColumns;
+    size_t mRowCount = 0;
+    size_t mSourceSize = 0;
+};
+
+// Binary column store written next to a CSV after it has been parsed once ("<csv>.colcache").
+// Layout: a fixed header (schema, row count, and the size, modification time and a sampled hash
+// of the source CSV), one descriptor per column, then 64-byte aligned int64/float64 column blocks.
+// The cache is rejected, and the CSV parsed again, as soon as the source or the schema changes.
+class ColumnCacheFile
+{
+public:
+    static std::string pathFor(const std::string& csvFilename);
+
+    // Maps the cache of csvFilename if it exists and still matches the CSV and the requested
+    // schema. Returns an empty table otherwise.
+    static ColumnTable open(const std::string& csvFilename, const std::vector<ColumnType>& schema, char delimiter,
+        TimestampFormat timestampFormat);
+
+    // Writes the cache for csvFilename (via a temporary file, so readers never see half of it).
+    static bool write(const std::string& csvFilename, const TypedCsv& csv, char delimiter, TimestampFormat timestampFormat);
+};
+
+// Loads a CSV as typed columns, from its cache when that is up to date, and otherwise by parsing
+// it (see readCsvTyped) and refreshing the cache for the next launch.
+ColumnTable loadColumnTable(const std::string& csvFilename, const std::vector<ColumnType>& schema, char delimiter = ',',
+    size_t threadCount = 1, TimestampFormat timestampFormat = TimestampFormat::DayMonthYearMinutes);
+
+// Receives one block of rows from loadColumnTableInBlocks. firstRow is the index of the block's
+// first row in the file, bytesDone and bytesTotal tell how far loading has got. Returning false
+// cancels the load.
+using ColumnBlockCallback = std::function<bool(const ColumnTable& rows, size_t firstRow, size_t bytesDone, size_t bytesTotal)>;
+
+// Same as loadColumnTable, but hands the rows over in blocks as soon as each one is parsed, so a
+// caller can show the start of a large file while the rest is still being read. The CSV is parsed
+// in blocks of whole lines, the first about firstBlockBytes long and every following one twice
+// the previous (up to 64 times the first), so work a caller repeats on everything received so far
+// adds up to little more than doing it once. An up to date cache arrives as a single block.
+// Returns the CSV bytes covered (see ColumnTable::sourceSize); 0 if the load was cancelled.
+size_t loadColumnTableInBlocks(const std::string& csvFilename, const std::vector<ColumnType>& schema, char delimiter,
+    size_t threadCount, TimestampFormat timestampFormat, size_t firstBlockBytes, const ColumnBlockCallback& onBlock);
+
+#endif // COLUMN_CACHE_H
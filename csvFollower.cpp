@@ -0,0 +1,49 @@
+// csvFollower.cpp
+#include "csvFollower.h"
+
+CsvFollower::CsvFollower(const QString& filename, const std::vector<ColumnType>& schema, char delimiter,
+    TimestampFormat timestampFormat, size_t startOffset, QObject* parent)
+    : QObject(parent),
+    mFilename(filename),
+    mWatcher(new QFileSystemWatcher(this)),
+    mFallbackTimer(new QTimer(this)),
+    mReader(filename.toStdString(), schema, delimiter, timestampFormat, startOffset)
+{
+    mWatcher->addPath(mFilename);
+    connect(mWatcher, &QFileSystemWatcher::fileChanged, this, &CsvFollower::poll);
+
+    mFallbackTimer->setInterval(1000); // The logger writes at most once a second
+    connect(mFallbackTimer, &QTimer::timeout, this, &CsvFollower::poll);
+    mFallbackTimer->start();
+
+    // Catch rows written between the initial load and now
+    QTimer::singleShot(0, this, &CsvFollower::poll);
+}
+
+void CsvFollower::poll()
+{
+    if (!mFallbackTimer->isActive()) {
+        return; // Stopped following
+    }
+
+    // Some platforms stop watching a file once it has been replaced by a rename
+    if (!mWatcher->files().contains(mFilename)) {
+        mWatcher->addPath(mFilename);
+    }
+
+    TypedCsv rows;
+    switch (mReader.poll(rows)) {
+    case TailStatus::Appended:
+        if (!rows.empty()) {
+            emit rowsAppended(rows);
+        }
+        break;
+    case TailStatus::Truncated:
+        mWatcher->removePath(mFilename);
+        mFallbackTimer->stop();
+        emit stopped(QString("'%1' was truncated or replaced; restart to load it again").arg(mFilename));
+        break;
+    default:
+        break; // Nothing new yet, or the writer holds the file; try again on the next change
+    }
+}
\ No newline at end of file
@@ -0,0 +1,38 @@
+// csvFollower.h
+#ifndef CSV_FOLLOWER_H
+#define CSV_FOLLOWER_H
+
+#include <QObject>
+#include <QString>
+#include <QFileSystemWatcher>
+#include <QTimer>
+#include "csvTailReader.h"
+
+// Watches a logger CSV and emits the rows appended to it, parsed with the same schema as the
+// initial load. Change notifications come from QFileSystemWatcher; a slow timer backs it up, as
+// some writers only update the file metadata when they close it.
+class CsvFollower : public QObject
+{
+    Q_OBJECT
+
+public:
+    CsvFollower(const QString& filename, const std::vector<ColumnType>& schema, char delimiter,
+        TimestampFormat timestampFormat, size_t startOffset, QObject* parent = nullptr);
+
+signals:
+    // Emitted (on the GUI thread) with the rows of every batch of complete new lines.
+    void rowsAppended(const TypedCsv& rows);
+    // Emitted once when following ends because the file was truncated or replaced.
+    void stopped(const QString& reason);
+
+private slots:
+    void poll();
+
+private:
+    QString mFilename;
+    QFileSystemWatcher* mWatcher;
+    QTimer* mFallbackTimer;
+    CsvTailReader mReader;
+};
+
+#endif // CSV_FOLLOWER_H
\ No newline at end of file
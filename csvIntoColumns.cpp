@@ -1,77 +1,221 @@
 // csvIntoColumns.cpp
 
 #include "csvIntoColumns.h" 
-#include <fstream>   
-#include <sstream>   
+#include "csvStructuralIndex.h"
+#include "threadPool.h"
 #include <iostream>  
 #include <algorithm> 
 
-// Function to read the CSV and return data organized by columns
-std::vector<std::vector<std::string>> readCsv(const std::string& filename, char delimiter)
+// Skips the UTF-8 byte order mark that Excel writes at the start of exported CSV files
+size_t skipByteOrderMark(std::string_view text)
 {
-    // Temporary storage for data in row-major format (how it's read from file)
-    std::vector<std::vector<std::string>> row_major_data;
-    std::ifstream file(filename); // Attempt to open the file
+    return (text.size() >= 3 && text.compare(0, 3, "\xEF\xBB\xBF") == 0) ? 3 : 0;
+}
 
-    // Check if the file was successfully opened
-    if (!file.is_open()) {
-        std::cerr << "Error: Could not open file '" << filename << "'" << std::endl;
-        return {}; // Return an empty vector indicating failure
+// Splits text into at most chunkCount pieces that each end just after a newline (or at the end)
+std::vector<std::string_view> splitCsvIntoChunks(std::string_view text, size_t chunkCount)
+{
+    std::vector<std::string_view> chunks;
+    if (text.empty()) {
+        return chunks;
     }
 
-    std::string line;
-    size_t max_cols = 0; // Keep track of the maximum number of columns found in any row
-
-    // Read file line by line
-    while (std::getline(file, line))
-    {
-        std::vector<std::string> row; // Stores cells for the current row
-        std::string current_cell_content;
-
-        // Parse each character in the line to extract cells
-        for (char c : line) {
-            if (c == delimiter) {
-                // If delimiter found and not inside quotes, add accumulated cell content
-                row.push_back(current_cell_content);
-                current_cell_content.clear(); // Reset for next cell
-            }
-            else {
-                current_cell_content += c; // Accumulate characters for current cell
+    // Tiny chunks cost more in scheduling than they save in parsing
+    const size_t minimum_chunk_size = size_t(1) << 20;
+    chunkCount = std::max<size_t>(1, std::min(chunkCount, text.size() / minimum_chunk_size));
+    const size_t target_size = text.size() / chunkCount;
+
+    size_t chunk_begin = 0;
+    while (chunk_begin < text.size()) {
+        size_t chunk_end = text.size();
+        if (chunks.size() + 1 < chunkCount) {
+            // Move the nominal boundary forward to the next line break
+            size_t newline = text.find('\n', std::min(text.size(), chunk_begin + target_size));
+            if (newline != std::string_view::npos) {
+                chunk_end = newline + 1;
             }
         }
-        row.push_back(current_cell_content); // Add the last cell of the line
+        chunks.push_back(text.substr(chunk_begin, chunk_end - chunk_begin));
+        chunk_begin = chunk_end;
+    }
+    return chunks;
+}
+
+namespace {
+
+// Cells of one chunk, organized by columns; rows shorter than the chunk's widest row are padded
+struct CsvSegment
+{
+    std::vector<std::vector<std::string_view>> columns;
+    size_t rowCount = 0;
+};
+
+// Output column of every file column up to the last selected one; NotSelected for the others
+const size_t NotSelected = static_cast<size_t>(-1);
 
-        // Add the parsed row to the row_major_data, if it's not entirely empty
-        if (!row.empty() || !line.empty()) {
-            row_major_data.push_back(row);
-            max_cols = std::max(max_cols, row.size()); // Update max_cols
+std::vector<size_t> selectionSlots(const ColumnSelection& selection)
+{
+    std::vector<size_t> slots;
+    for (size_t i = 0; i < selection.size(); ++i) {
+        if (selection[i] >= slots.size()) {
+            slots.resize(selection[i] + 1, NotSelected);
         }
+        slots[selection[i]] = i;
+    }
+    return slots;
+}
+
+// Walks the structural index of a chunk; each cell becomes a view into the file, so no cell is copied
+CsvSegment parseCsvSegment(std::string_view chunk, char delimiter)
+{
+    // A quick newline count lets every column reserve its final size up front
+    size_t expected_rows = countLineBreaks(chunk) + 1;
+
+    CsvSegment segment;
+    forEachCsvCell(chunk, delimiter,
+        [&](size_t col_idx, std::string_view cell) {
+            // A column seen for the first time is padded for all rows that did not have it
+            if (col_idx == segment.columns.size()) {
+                segment.columns.emplace_back();
+                segment.columns.back().reserve(expected_rows);
+                segment.columns.back().resize(segment.rowCount);
+            }
+            segment.columns[col_idx].push_back(cell);
+        },
+        [&](size_t cell_count) {
+            ++segment.rowCount;
+
+            // Pad the columns this row was too short for, to maintain column length consistency
+            for (size_t i = cell_count; i < segment.columns.size(); ++i) {
+                segment.columns[i].emplace_back();
+            }
+        });
+    return segment;
+}
+
+// Same for the selected columns only; slots comes from selectionSlots
+CsvSegment parseSelectedCsvSegment(std::string_view chunk, char delimiter, const std::vector<size_t>& slots, size_t selectedCount)
+{
+    size_t expected_rows = countLineBreaks(chunk) + 1;
+
+    CsvSegment segment;
+    segment.columns.resize(selectedCount);
+    for (std::vector<std::string_view>& column : segment.columns) {
+        column.reserve(expected_rows);
+    }
+    forEachCsvCell(chunk, delimiter,
+        [&](size_t col_idx, std::string_view cell) {
+            if (col_idx < slots.size() && slots[col_idx] != NotSelected) {
+                segment.columns[slots[col_idx]].push_back(cell);
+            }
+        },
+        [&](size_t cell_count) {
+            ++segment.rowCount;
+
+            // Selected columns past the end of a short row get an empty cell
+            for (size_t i = cell_count; i < slots.size(); ++i) {
+                if (slots[i] != NotSelected) {
+                    segment.columns[slots[i]].emplace_back();
+                }
+            }
+        });
+    return segment;
+}
+
+} // namespace
+
+// Function to map the CSV and return views of its cells organized by columns
+CsvView readCsvMapped(const std::string& filename, char delimiter, size_t threadCount, const ColumnSelection& selection)
+{
+    auto file = std::make_shared<MappedFile>(filename);
+
+    // Check if the file was successfully opened
+    if (!file->isOpen()) {
+        std::cerr << "Error: Could not open file '" << filename << "'" << std::endl;
+        return {}; // Return an empty view indicating failure
     }
 
-    // Now, transpose the row-major data into column-major format.
-    if (row_major_data.empty()) {
+    std::string_view text = file->view();
+    text.remove_prefix(skipByteOrderMark(text));
+    if (text.empty()) {
         return {}; // No data was read
     }
 
-    // Initialize the final column_major_data vector with the correct number of columns
-    // Each inner vector will store elements for one column
-    std::vector<std::vector<std::string>> column_major_data(max_cols);
+    ThreadPool& pool = ThreadPool::shared();
+    const std::vector<std::string_view> chunks = splitCsvIntoChunks(text, threadCount == 0 ? pool.threadCount() : threadCount);
 
-    // Populate column_major_data by transposing row_major_data
-    for (const auto& row : row_major_data) {
-        for (size_t col_idx = 0; col_idx < max_cols; ++col_idx) {
-            // If the current row has a value for this column index, use it
-            if (col_idx < row.size()) {
-                column_major_data[col_idx].push_back(row[col_idx]);
-            }
-            else {
-                // Otherwise, pad with an empty string to maintain column length consistency
-                column_major_data[col_idx].push_back("");
+    CsvView csv;
+    csv.file = file;
+
+    const std::vector<size_t> slots = selectionSlots(selection);
+    auto parseSegment = [delimiter, &slots, &selection](std::string_view chunk) {
+        return selection.empty() ? parseCsvSegment(chunk, delimiter) : parseSelectedCsvSegment(chunk, delimiter, slots, selection.size());
+    };
+
+    if (chunks.size() == 1) {
+        CsvSegment segment = parseSegment(chunks.front());
+        csv.columns = std::move(segment.columns);
+        csv.rowCount = segment.rowCount;
+        return csv;
+    }
+
+    // Parse every chunk on the pool into its own column segments
+    std::vector<std::future<CsvSegment>> pending;
+    pending.reserve(chunks.size());
+    for (std::string_view chunk : chunks) {
+        pending.push_back(pool.submit([chunk, &parseSegment]() { return parseSegment(chunk); }));
+    }
+    std::vector<CsvSegment> segments;
+    segments.reserve(chunks.size());
+    size_t max_cols = 0;
+    for (auto& result : pending) {
+        segments.push_back(result.get());
+        max_cols = std::max(max_cols, segments.back().columns.size());
+        csv.rowCount += segments.back().rowCount;
+    }
+
+    // Stitch the segments in file order, padding segments narrower than the widest row of the file
+    csv.columns.resize(max_cols);
+    std::vector<std::future<void>> stitching;
+    stitching.reserve(max_cols);
+    for (size_t col_idx = 0; col_idx < max_cols; ++col_idx) {
+        stitching.push_back(pool.submit([&csv, &segments, col_idx]() {
+            std::vector<std::string_view>& column = csv.columns[col_idx];
+            column.reserve(csv.rowCount);
+            for (const CsvSegment& segment : segments) {
+                if (col_idx < segment.columns.size()) {
+                    column.insert(column.end(), segment.columns[col_idx].begin(), segment.columns[col_idx].end());
+                }
+                else {
+                    column.resize(column.size() + segment.rowCount);
+                }
             }
+        }));
+    }
+    for (auto& result : stitching) {
+        result.get();
+    }
+
+    return csv;
+}
+
+// Function to copy the mapped cells into the owning column-major format
+std::vector<std::vector<std::string>> toStringColumns(const CsvView& csv)
+{
+    std::vector<std::vector<std::string>> column_major_data(csv.columns.size());
+    for (size_t col_idx = 0; col_idx < csv.columns.size(); ++col_idx) {
+        column_major_data[col_idx].reserve(csv.columns[col_idx].size());
+        for (std::string_view cell : csv.columns[col_idx]) {
+            column_major_data[col_idx].emplace_back(cell);
         }
     }
+    return column_major_data;
+}
 
-    return column_major_data; // Return the data organized by columns
+// Function to read the CSV and return data organized by columns
+std::vector<std::vector<std::string>> readCsv(const std::string& filename, char delimiter, const ColumnSelection& selection)
+{
+    return toStringColumns(readCsvMapped(filename, delimiter, 1, selection));
 }
 
 // Function to print the CSV data that is organized by columns
@@ -4,11 +4,46 @@
 
 #include <vector>
 #include <string>
+#include <string_view>
+#include <memory>
+#include "mappedFile.h"
 
-// Reads a CSV file and organizes its data into columns.
- 
+// Column-major view of a CSV file whose cells point straight into the memory-mapped file.
+// Rows shorter than the widest row (or than the last selected column) are padded with empty
+// views, exactly like readCsv pads with empty strings. The cells stay valid for as long as the CsvView (or a copy of it) lives.
+struct CsvView
+{
+    std::shared_ptr<const MappedFile> file; // Owns the mapping the cells point into
+    std::vector<std::vector<std::string_view>> columns;
+    size_t rowCount = 0;
 
-std::vector<std::vector<std::string>> readCsv(const std::string& filename, char delimiter = ',');
+    bool empty() const { return columns.empty(); }
+};
+
+// Returns the length of a UTF-8 byte order mark at the start of text (0 or 3).
+size_t skipByteOrderMark(std::string_view text);
+
+// Splits text into at most chunkCount pieces that each end just after a newline (or at the end),
+// so every piece holds whole lines. Small inputs yield fewer pieces.
+std::vector<std::string_view> splitCsvIntoChunks(std::string_view text, size_t chunkCount);
+
+// Columns to read, as 0-based indices into the file's rows, each at most once. The result holds
+// them in this order. An empty selection reads every column.
+using ColumnSelection = std::vector<size_t>;
+
+// Memory-maps a CSV file and splits it into columns without copying any cell.
+// With threadCount other than 1 the file is split at line boundaries and the chunks are parsed
+// in parallel (0 uses every core); the result is identical to the single-threaded one.
+// Cells of columns outside the selection are neither stored nor copied.
+CsvView readCsvMapped(const std::string& filename, char delimiter = ',', size_t threadCount = 1,
+    const ColumnSelection& selection = {});
+
+// Copies a CsvView into the owning column-major layout returned by readCsv.
+std::vector<std::vector<std::string>> toStringColumns(const CsvView& csv);
+
+// Reads a CSV file and organizes its data into columns (only the selected ones, if any).
+std::vector<std::vector<std::string>> readCsv(const std::string& filename, char delimiter = ',',
+    const ColumnSelection& selection = {});
 
 // Prints the CSV data that is organized by columns.
 
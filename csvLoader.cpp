@@ -0,0 +1,73 @@
+// csvLoader.cpp
+#include "csvLoader.h"
+#include <utility>   // Required for std::move
+
+namespace {
+
+// First block handed to the plots; small, so they show something right away
+const size_t FirstBlockBytes = size_t(4) << 20;
+
+} // namespace
+
+CsvLoader::CsvLoader(const QString& filename, const std::vector<ColumnType>& schema, char delimiter,
+    TimestampFormat timestampFormat, Converter convert, QObject* parent)
+    : QObject(parent),
+    mFilename(filename),
+    mSchema(schema),
+    mDelimiter(delimiter),
+    mTimestampFormat(timestampFormat),
+    mConvert(std::move(convert)),
+    mThread(nullptr),
+    mCancelled(false)
+{
+    qRegisterMetaType<PlotDataset>("PlotDataset"); // Travels from the worker to the GUI thread
+}
+
+CsvLoader::~CsvLoader()
+{
+    cancel();
+    if (mThread) {
+        mThread->wait();
+    }
+}
+
+void CsvLoader::start()
+{
+    if (mThread) {
+        return;
+    }
+    mThread = QThread::create([this]() { run(); });
+    mThread->setParent(this);
+    mThread->start();
+}
+
+void CsvLoader::cancel()
+{
+    mCancelled = true;
+}
+
+// Worker thread: signals are queued to the receivers on the GUI thread, in emission order
+void CsvLoader::run()
+{
+    size_t rowCount = 0;
+    const size_t sourceSize = loadColumnTableInBlocks(mFilename.toStdString(), mSchema, mDelimiter, 0, mTimestampFormat,
+        FirstBlockBytes, [this, &rowCount](const ColumnTable& rows, size_t firstRow, size_t bytesDone, size_t bytesTotal) {
+            if (mCancelled) {
+                return false;
+            }
+            emit rowsLoaded(mConvert(rows, firstRow));
+            emit progress(static_cast<qint64>(bytesDone), static_cast<qint64>(bytesTotal));
+            rowCount += rows.rowCount();
+            return true;
+        });
+
+    if (mCancelled) {
+        emit cancelled();
+    }
+    else if (rowCount == 0) {
+        emit failed(QString("No data read from '%1' (missing, empty or unreadable)").arg(mFilename));
+    }
+    else {
+        emit finished(static_cast<qint64>(sourceSize));
+    }
+}
\ No newline at end of file
@@ -0,0 +1,52 @@
+// csvLoader.h
+#ifndef CSV_LOADER_H
+#define CSV_LOADER_H
+
+#include <QObject>
+#include <QString>
+#include <QThread>
+#include <atomic>
+#include <functional>
+#include "columnCache.h"
+#include "plotDataset.h"
+
+// Loads a logger CSV (or its column cache) on a worker thread, so the window can come up at once.
+// Rows are handed over in blocks as they are parsed, already converted into plot channels; see
+// loadColumnTableInBlocks for how the blocks are sized.
+class CsvLoader : public QObject
+{
+    Q_OBJECT
+
+public:
+    // Turns a block of parsed rows into plot channels. Runs on the worker thread, one block at a
+    // time; firstRow is the block's position in the file (for error messages).
+    using Converter = std::function<PlotDataset(const ColumnTable& rows, size_t firstRow)>;
+
+    CsvLoader(const QString& filename, const std::vector<ColumnType>& schema, char delimiter,
+        TimestampFormat timestampFormat, Converter convert, QObject* parent = nullptr);
+    ~CsvLoader(); // Cancels a running load and waits for the worker
+
+    void start();
+    void cancel(); // Stops after the block being parsed; emits cancelled()
+
+signals:
+    void rowsLoaded(const PlotDataset& rows);
+    void progress(qint64 bytesDone, qint64 bytesTotal);
+    // Emitted once, after the last block, with the CSV bytes loaded (where following can start).
+    void finished(qint64 sourceSize);
+    void cancelled();
+    void failed(const QString& reason);
+
+private:
+    QString mFilename;
+    std::vector<ColumnType> mSchema;
+    char mDelimiter;
+    TimestampFormat mTimestampFormat;
+    Converter mConvert;
+    QThread* mThread;
+    std::atomic<bool> mCancelled;
+
+    void run();
+};
+
+#endif // CSV_LOADER_H
\ No newline at end of file
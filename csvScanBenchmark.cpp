@@ -0,0 +1,110 @@
+// csvScanBenchmark.cpp
+//
+// Standalone throughput benchmark for the CSV tokenizer (not part of the application build).
+// Repeats Book1.csv into a large scratch file and reports bytes/second for the old byte-by-byte
+// loop, each structural scanning kernel, and the full typed parse.
+//
+// Build (GCC/Clang):
+//   g++ -std=c++17 -O2 -pthread csvScanBenchmark.cpp csvStructuralIndex.cpp csvToTypedColumns.cpp
+//       csvIntoColumns.cpp mappedFile.cpp threadPool.cpp stringToFloatVector.cpp timestampParser.cpp
+//       -o csvScanBenchmark
+// Run:
+//   ./csvScanBenchmark [source.csv] [size in MB, default 1024]
+
+#include "csvStructuralIndex.h"
+#include "csvToTypedColumns.h"
+#include "mappedFile.h"
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <cstdio>   // Required for std::remove
+#include <algorithm>  // Required for std::min
+#include <functional>
+#include <iterator>   // Required for std::istreambuf_iterator
+#include <string>
+#include <vector>
+
+namespace {
+
+// Runs a pass over the data and prints its throughput; the checksum keeps the work observable
+void report(const char* name, size_t bytes, const std::function<size_t()>& pass)
+{
+    auto start = std::chrono::steady_clock::now();
+    size_t checksum = pass();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << name << ": " << (bytes / seconds) / (1024.0 * 1024.0) << " MB/s"
+        << " (" << seconds << " s, checksum " << checksum << ")" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    const std::string sourceFilename = argc > 1 ? argv[1] : "Book1.csv";
+    const size_t targetMegabytes = argc > 2 ? std::stoul(argv[2]) : 1024;
+    const std::string scaledFilename = "csvScanBenchmark.tmp.csv";
+
+    // Scale the sample log up by repeating it
+    {
+        std::ifstream source(sourceFilename, std::ios::binary);
+        std::string sample((std::istreambuf_iterator<char>(source)), std::istreambuf_iterator<char>());
+        if (sample.size() >= 3 && sample.compare(0, 3, "\xEF\xBB\xBF") == 0) {
+            sample.erase(0, 3);
+        }
+        if (sample.empty()) {
+            std::cerr << "Error: Could not read '" << sourceFilename << "'" << std::endl;
+            return 1;
+        }
+        if (sample.back() != '\n') {
+            sample += '\n';
+        }
+        std::ofstream scaled(scaledFilename, std::ios::binary);
+        for (size_t written = 0; written < targetMegabytes * 1024 * 1024; written += sample.size()) {
+            scaled.write(sample.data(), static_cast<std::streamsize>(sample.size()));
+        }
+    }
+
+    size_t bytes = 0;
+    {
+        MappedFile file(scaledFilename);
+        const std::string_view text = file.view();
+        bytes = text.size();
+        std::cout << "Scanning " << bytes / (1024 * 1024) << " MB" << std::endl;
+
+        // Baseline: the original readCsv inner loop, one char compare at a time
+        report("byte loop        ", bytes, [&]() {
+            size_t cells = 0;
+            for (char c : text) {
+                if (c == ',' || c == '\n') {
+                    ++cells;
+                }
+            }
+            return cells;
+        });
+
+        // Structural index, 64 KiB blocks at a time
+        std::vector<std::uint32_t> positions(size_t(1) << 16);
+        auto scanWith = [&](StructuralKernel kernel) {
+            size_t found = 0;
+            for (size_t offset = 0; offset < text.size(); offset += positions.size()) {
+                size_t length = std::min(positions.size(), text.size() - offset);
+                found += findStructuralChars(text.data() + offset, length, ',', positions.data(), kernel);
+            }
+            return found;
+        };
+        report("index scalar     ", bytes, [&]() { return scanWith(StructuralKernel::Scalar); });
+        report("index SSE2       ", bytes, [&]() { return scanWith(StructuralKernel::Sse2); });
+        if (bestStructuralKernel() == StructuralKernel::Avx2) {
+            report("index AVX2       ", bytes, [&]() { return scanWith(StructuralKernel::Avx2); });
+        }
+    }
+
+    // End to end: tokenize and convert every field into typed columns
+    std::vector<ColumnType> schema(11, ColumnType::Numeric);
+    schema[0] = ColumnType::Timestamp;
+    report("typed, 1 thread  ", bytes, [&]() { return readCsvTyped(scaledFilename, schema, ',', 1).rowCount; });
+    report("typed, all cores ", bytes, [&]() { return readCsvTyped(scaledFilename, schema, ',', 0).rowCount; });
+
+    std::remove(scaledFilename.c_str());
+    return 0;
+}
@@ -0,0 +1,216 @@
+// csvStructuralIndex.cpp
+
+#include "csvStructuralIndex.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define CSV_SCAN_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// MSVC accepts AVX2 intrinsics in any function; GCC and Clang need the function to opt in
+#if defined(CSV_SCAN_X86) && (defined(__GNUC__) || defined(__clang__))
+#define CSV_SCAN_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define CSV_SCAN_TARGET_AVX2
+#endif
+
+namespace {
+
+// Index of the lowest set bit of a non-zero mask
+inline unsigned lowestBit(std::uint64_t mask)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+#if defined(_M_X64)
+    _BitScanForward64(&index, mask);
+#else
+    if (!_BitScanForward(&index, static_cast<unsigned long>(mask))) {
+        _BitScanForward(&index, static_cast<unsigned long>(mask >> 32));
+        index += 32;
+    }
+#endif
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctzll(mask));
+#endif
+}
+
+inline unsigned popCount(std::uint64_t mask)
+{
+#ifdef _MSC_VER
+    unsigned count = 0;
+    for (; mask != 0; mask &= mask - 1) {
+        ++count;
+    }
+    return count;
+#else
+    return static_cast<unsigned>(__builtin_popcountll(mask));
+#endif
+}
+
+// Turns the set bits of a 64-byte block mask into offsets
+inline size_t emitPositions(std::uint64_t mask, size_t base, std::uint32_t* positions, size_t count)
+{
+    while (mask != 0) {
+        positions[count++] = static_cast<std::uint32_t>(base + lowestBit(mask));
+        mask &= mask - 1;
+    }
+    return count;
+}
+
+size_t findScalar(const char* data, size_t begin, size_t size, char delimiter, std::uint32_t* positions, size_t count)
+{
+    for (size_t i = begin; i < size; ++i) {
+        if (data[i] == delimiter || data[i] == '\n') {
+            positions[count++] = static_cast<std::uint32_t>(i);
+        }
+    }
+    return count;
+}
+
+#ifdef CSV_SCAN_X86
+
+// Bit i of the result is set when block[i] is the delimiter or a newline
+inline std::uint64_t structuralMaskSse2(const char* block, __m128i delimiters, __m128i newlines)
+{
+    std::uint64_t mask = 0;
+    for (int part = 0; part < 4; ++part) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + part * 16));
+        __m128i hits = _mm_or_si128(_mm_cmpeq_epi8(bytes, delimiters), _mm_cmpeq_epi8(bytes, newlines));
+        mask |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm_movemask_epi8(hits)) & 0xFFFFu) << (part * 16);
+    }
+    return mask;
+}
+
+CSV_SCAN_TARGET_AVX2
+inline std::uint64_t structuralMaskAvx2(const char* block, __m256i delimiters, __m256i newlines)
+{
+    __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+    __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32));
+    __m256i low_hits = _mm256_or_si256(_mm256_cmpeq_epi8(low, delimiters), _mm256_cmpeq_epi8(low, newlines));
+    __m256i high_hits = _mm256_or_si256(_mm256_cmpeq_epi8(high, delimiters), _mm256_cmpeq_epi8(high, newlines));
+    return static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(low_hits))) |
+        (static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(high_hits))) << 32);
+}
+
+size_t findSse2(const char* data, size_t size, char delimiter, std::uint32_t* positions)
+{
+    const __m128i delimiters = _mm_set1_epi8(delimiter);
+    const __m128i newlines = _mm_set1_epi8('\n');
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 64 <= size; i += 64) {
+        count = emitPositions(structuralMaskSse2(data + i, delimiters, newlines), i, positions, count);
+    }
+    return findScalar(data, i, size, delimiter, positions, count);
+}
+
+CSV_SCAN_TARGET_AVX2
+size_t findAvx2(const char* data, size_t size, char delimiter, std::uint32_t* positions)
+{
+    const __m256i delimiters = _mm256_set1_epi8(delimiter);
+    const __m256i newlines = _mm256_set1_epi8('\n');
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 64 <= size; i += 64) {
+        count = emitPositions(structuralMaskAvx2(data + i, delimiters, newlines), i, positions, count);
+    }
+    return findScalar(data, i, size, delimiter, positions, count);
+}
+
+size_t countSse2(const char* data, size_t size)
+{
+    const __m128i newlines = _mm_set1_epi8('\n');
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 64 <= size; i += 64) {
+        count += popCount(structuralMaskSse2(data + i, newlines, newlines));
+    }
+    for (; i < size; ++i) {
+        count += (data[i] == '\n');
+    }
+    return count;
+}
+
+CSV_SCAN_TARGET_AVX2
+size_t countAvx2(const char* data, size_t size)
+{
+    const __m256i newlines = _mm256_set1_epi8('\n');
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 64 <= size; i += 64) {
+        count += popCount(structuralMaskAvx2(data + i, newlines, newlines));
+    }
+    for (; i < size; ++i) {
+        count += (data[i] == '\n');
+    }
+    return count;
+}
+
+bool cpuSupportsAvx2()
+{
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+    __cpuid(info, 1);
+    const bool osSavesYmm = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6; // OSXSAVE, XMM and YMM state
+    __cpuidex(info, 7, 0);
+    return osSavesYmm && (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif // CSV_SCAN_X86
+
+} // namespace
+
+StructuralKernel bestStructuralKernel()
+{
+#ifdef CSV_SCAN_X86
+    static const StructuralKernel kernel = cpuSupportsAvx2() ? StructuralKernel::Avx2 : StructuralKernel::Sse2;
+    return kernel;
+#else
+    return StructuralKernel::Scalar;
+#endif
+}
+
+size_t findStructuralChars(const char* data, size_t size, char delimiter, std::uint32_t* positions, StructuralKernel kernel)
+{
+    switch (kernel) {
+#ifdef CSV_SCAN_X86
+    case StructuralKernel::Avx2:
+        return findAvx2(data, size, delimiter, positions);
+    case StructuralKernel::Sse2:
+        return findSse2(data, size, delimiter, positions);
+#endif
+    default:
+        return findScalar(data, 0, size, delimiter, positions, 0);
+    }
+}
+
+size_t countLineBreaks(std::string_view text, StructuralKernel kernel)
+{
+    switch (kernel) {
+#ifdef CSV_SCAN_X86
+    case StructuralKernel::Avx2:
+        return countAvx2(text.data(), text.size());
+    case StructuralKernel::Sse2:
+        return countSse2(text.data(), text.size());
+#endif
+    default:
+        break;
+    }
+
+    size_t count = 0;
+    for (char c : text) {
+        count += (c == '\n');
+    }
+    return count;
+}
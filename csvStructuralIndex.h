@@ -0,0 +1,90 @@
+// csvStructuralIndex.h
+#ifndef CSV_STRUCTURAL_INDEX_H
+#define CSV_STRUCTURAL_INDEX_H
+
+#include <vector>
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+
+// Instruction set used to find the structural characters (delimiters and newlines) of a CSV.
+enum class StructuralKernel
+{
+    Scalar, // One byte at a time
+    Sse2,   // 64 bytes per step as four 16-byte compares
+    Avx2    // 64 bytes per step as two 32-byte compares
+};
+
+// Fastest kernel supported by the CPU we are running on (detected once).
+StructuralKernel bestStructuralKernel();
+
+// Writes the offset of every delimiter and '\n' in data[0, size) to positions, in increasing
+// order, and returns how many were found. positions must have room for size entries and size
+// must be below 4 GiB (callers index blocks, see forEachCsvCell).
+size_t findStructuralChars(const char* data, size_t size, char delimiter, std::uint32_t* positions,
+    StructuralKernel kernel = bestStructuralKernel());
+
+// Counts the '\n' bytes of text with the same vector kernels.
+size_t countLineBreaks(std::string_view text, StructuralKernel kernel = bestStructuralKernel());
+
+// Tokenizes text (whole lines, the last one may lack its '\n') by building a structural index
+// block by block and walking it. For every cell onCell(columnIndex, cell) is called, and at the
+// end of every line onLineEnd(cellCount). A '\r' before the '\n' is stripped, as std::getline in
+// text mode does, and every line (even an empty one) holds at least one cell.
+template <class CellFunction, class LineFunction>
+void forEachCsvCell(std::string_view text, char delimiter, CellFunction&& onCell, LineFunction&& onLineEnd)
+{
+    // Blocks are cut at line breaks; 64 KiB keeps the index in L2 next to the text it points into
+    const size_t block_size = size_t(1) << 16;
+    std::vector<std::uint32_t> positions;
+
+    size_t block_begin = 0;
+    while (block_begin < text.size()) {
+        // End the block after the last line break inside the window, or after the first one
+        // past it when a single line is longer than the window
+        size_t block_end = text.size();
+        if (block_begin + block_size < text.size()) {
+            size_t newline = text.rfind('\n', block_begin + block_size - 1);
+            if (newline == std::string_view::npos || newline < block_begin) {
+                newline = text.find('\n', block_begin + block_size);
+            }
+            if (newline != std::string_view::npos) {
+                block_end = newline + 1;
+            }
+        }
+
+        const char* block = text.data() + block_begin;
+        const size_t length = block_end - block_begin;
+        if (positions.size() < length + 1) {
+            positions.resize(length + 1);
+        }
+        size_t count = findStructuralChars(block, length, delimiter, positions.data());
+        if (block[length - 1] != '\n') {
+            positions[count++] = static_cast<std::uint32_t>(length); // Virtual line break at the end
+        }
+
+        // Walk the index: every position closes a cell, and a line break also closes the line
+        size_t cell_begin = 0;
+        size_t column = 0;
+        for (size_t i = 0; i < count; ++i) {
+            const size_t pos = positions[i];
+            if (pos < length && block[pos] != '\n') {
+                onCell(column++, std::string_view(block + cell_begin, pos - cell_begin));
+            }
+            else {
+                size_t cell_end = pos;
+                if (cell_end > cell_begin && block[cell_end - 1] == '\r') {
+                    --cell_end;
+                }
+                onCell(column++, std::string_view(block + cell_begin, cell_end - cell_begin));
+                onLineEnd(column);
+                column = 0;
+            }
+            cell_begin = pos + 1;
+        }
+
+        block_begin = block_end;
+    }
+}
+
+#endif // CSV_STRUCTURAL_INDEX_H
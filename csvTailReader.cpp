@@ -0,0 +1,79 @@
+// csvTailReader.cpp
+
+#include "csvTailReader.h"
+#include "csvIntoColumns.h"  // Required for skipByteOrderMark
+#include <fstream>
+#include <filesystem>
+#include <system_error>
+#include <string_view>
+
+CsvTailReader::CsvTailReader(const std::string& filename, const std::vector<ColumnType>& schema, char delimiter,
+    TimestampFormat timestampFormat, size_t startOffset)
+    : mFilename(filename), mSchema(schema), mDelimiter(delimiter), mTimestampFormat(timestampFormat), mOffset(startOffset)
+{
+}
+
+TailStatus CsvTailReader::poll(TypedCsv& rows)
+{
+    rows = TypedCsv();
+
+    std::error_code error;
+    const std::uintmax_t size = std::filesystem::file_size(mFilename, error);
+    if (error) {
+        return TailStatus::Unreadable;
+    }
+    if (size < mOffset) {
+        return TailStatus::Truncated;
+    }
+    if (size == mOffset) {
+        return TailStatus::Unchanged;
+    }
+
+    std::ifstream file(mFilename, std::ios::binary);
+    if (!file.is_open()) {
+        return TailStatus::Unreadable;
+    }
+
+    // The loaded data ended mid-line if the byte before the start offset is not a line break
+    if (!mCheckedStart && mOffset > 0) {
+        char previous = '\n';
+        file.seekg(static_cast<std::streamoff>(mOffset - 1));
+        file.get(previous);
+        mSkipToLineEnd = previous != '\n';
+    }
+    mCheckedStart = true;
+
+    // Read only the appended bytes
+    const size_t appended = static_cast<size_t>(size - mOffset);
+    const size_t pending = mPending.size();
+    mPending.resize(pending + appended);
+    file.seekg(static_cast<std::streamoff>(mOffset));
+    file.read(&mPending[pending], static_cast<std::streamsize>(appended));
+    if (!file) {
+        mPending.resize(pending);
+        return TailStatus::Unreadable;
+    }
+    if (mOffset == 0) {
+        mPending.erase(0, skipByteOrderMark(mPending));
+    }
+    mOffset = static_cast<size_t>(size);
+
+    if (mSkipToLineEnd) {
+        size_t line_end = mPending.find('\n');
+        if (line_end == std::string::npos) {
+            mPending.clear();
+            return TailStatus::Unchanged;
+        }
+        mPending.erase(0, line_end + 1);
+        mSkipToLineEnd = false;
+    }
+
+    // Parse the complete lines; keep the partial one for the next poll
+    size_t last_newline = mPending.rfind('\n');
+    if (last_newline == std::string::npos) {
+        return TailStatus::Unchanged;
+    }
+    rows = parseCsvTyped(std::string_view(mPending.data(), last_newline + 1), mSchema, mDelimiter, 1, mTimestampFormat);
+    mPending.erase(0, last_newline + 1);
+    return TailStatus::Appended;
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+// csvTailReader.h
+#ifndef CSV_TAIL_READER_H
+#define CSV_TAIL_READER_H
+
+#include <vector>
+#include <string>
+#include "csvToTypedColumns.h"
+
+// Result of one CsvTailReader::poll.
+enum class TailStatus
+{
+    Unchanged, // Nothing new, or only part of a line so far
+    Appended,  // Complete new lines were parsed
+    Truncated, // The file shrank (rotated or rewritten); reading stops
+    Unreadable // The file could not be opened or sized this time
+};
+
+// Follows a CSV that another process keeps appending to. Every poll reads only the bytes added
+// since the previous one and parses the complete lines among them; a trailing partial line is
+// held back until its '\n' arrives.
+class CsvTailReader
+{
+public:
+    // Starts reading at byte startOffset, typically the size the file had when it was loaded
+    // (see ColumnTable::sourceSize). If the loaded data ended in the middle of a line, the rest of
+    // that line is skipped, since its row has been loaded already.
+    CsvTailReader(const std::string& filename, const std::vector<ColumnType>& schema, char delimiter = ',',
+        TimestampFormat timestampFormat = TimestampFormat::DayMonthYearMinutes, size_t startOffset = 0);
+
+    // Parses the newly appended lines into rows (a TypedCsv with the reader's schema).
+    TailStatus poll(TypedCsv& rows);
+
+    size_t offset() const { return mOffset; } // Bytes of the file read so far
+
+private:
+    std::string mFilename;
+    std::vector<ColumnType> mSchema;
+    char mDelimiter;
+    TimestampFormat mTimestampFormat;
+    size_t mOffset;
+    std::string mPending;       // Read but not yet terminated by a '\n'
+    bool mCheckedStart = false; // Whether the byte before the start offset has been looked at
+    bool mSkipToLineEnd = false;
+};
+
+#endif // CSV_TAIL_READER_H
\ No newline at end of file
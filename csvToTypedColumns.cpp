@@ -0,0 +1,186 @@
+// csvToTypedColumns.cpp
+
+#include "csvToTypedColumns.h"
+#include "csvIntoColumns.h"  // Required for skipByteOrderMark, splitCsvIntoChunks
+#include "csvStructuralIndex.h"
+#include "mappedFile.h"
+#include "stringToFloatVector.h" // Required for parseDouble
+#include "threadPool.h"
+#include "timestampParser.h"
+#include <iostream>
+#include <algorithm>
+#include <limits>    // Required for std::numeric_limits<double>::quiet_NaN()
+#include <string_view>
+
+namespace {
+
+// Errors found while parsing one chunk
+struct ChunkErrors
+{
+    std::vector<size_t> counts;               // Per column
+    std::vector<std::vector<size_t>> badRows; // Per column, filled for timestamp columns only
+};
+
+// Number of rows in a chunk that ends just after a newline (or at the end of the file)
+size_t countRows(std::string_view chunk)
+{
+    if (chunk.empty()) {
+        return 0;
+    }
+    size_t rows = countLineBreaks(chunk);
+    return (chunk.back() != '\n') ? rows + 1 : rows; // Last line without a trailing newline
+}
+
+// Parses the rows of one chunk into csv, starting at row firstRow. Chunks write disjoint row
+// ranges of the preallocated buffers, so they can run concurrently.
+ChunkErrors parseTypedRows(std::string_view chunk, size_t firstRow, size_t lastStoredCol, char delimiter,
+    TimestampFormat timestampFormat, TypedCsv& csv)
+{
+    ChunkErrors errors;
+    errors.counts.assign(csv.columns.size(), 0);
+    errors.badRows.resize(csv.columns.size());
+    TimestampParser timestamps(timestampFormat); // Per chunk, its date cache is not shared
+    size_t row = firstRow;
+
+    forEachCsvCell(chunk, delimiter,
+        [&](size_t col_idx, std::string_view cell) {
+            if (col_idx >= lastStoredCol) {
+                return; // Never converted
+            }
+
+            // Parse the cell directly into its column
+            TypedColumn& column = csv.columns[col_idx];
+            if (column.type == ColumnType::Numeric) {
+                if (!parseDouble(cell, column.values[row])) {
+                    column.values[row] = std::numeric_limits<double>::quiet_NaN();
+                    ++errors.counts[col_idx];
+                }
+            }
+            else if (column.type == ColumnType::Timestamp) {
+                if (!timestamps.parse(cell, column.epochs[row])) {
+                    column.epochs[row] = 0;
+                    ++errors.counts[col_idx];
+                    errors.badRows[col_idx].push_back(row);
+                }
+            }
+        },
+        [&](size_t cell_count) {
+            // Cells missing from a short row are padded, like readCsv pads them with empty strings
+            for (size_t col_idx = cell_count; col_idx < lastStoredCol; ++col_idx) {
+                TypedColumn& column = csv.columns[col_idx];
+                if (column.type == ColumnType::Numeric) {
+                    column.values[row] = std::numeric_limits<double>::quiet_NaN();
+                    ++errors.counts[col_idx];
+                }
+                else if (column.type == ColumnType::Timestamp) {
+                    column.epochs[row] = 0;
+                    ++errors.counts[col_idx];
+                    errors.badRows[col_idx].push_back(row);
+                }
+            }
+            ++row;
+        });
+    return errors;
+}
+
+} // namespace
+
+// Function to read the CSV straight into typed column buffers, without intermediate strings
+TypedCsv readCsvTyped(const std::string& filename, const std::vector<ColumnType>& schema, char delimiter, size_t threadCount,
+    TimestampFormat timestampFormat)
+{
+    MappedFile file(filename);
+
+    // Check if the file was successfully opened
+    if (!file.isOpen()) {
+        std::cerr << "Error: Could not open file '" << filename << "'" << std::endl;
+        return {}; // Return an empty result indicating failure
+    }
+
+    std::string_view text = file.view();
+    text.remove_prefix(skipByteOrderMark(text));
+    return parseCsvTyped(text, schema, delimiter, threadCount, timestampFormat);
+}
+
+TypedCsv parseCsvTyped(std::string_view text, const std::vector<ColumnType>& schema, char delimiter, size_t threadCount,
+    TimestampFormat timestampFormat)
+{
+    if (text.empty()) {
+        return {}; // No data was read
+    }
+
+    ThreadPool& pool = ThreadPool::shared();
+    const std::vector<std::string_view> chunks = splitCsvIntoChunks(text, threadCount == 0 ? pool.threadCount() : threadCount);
+
+    // Every line is a row, so the newline count of each chunk gives its first row and the
+    // exact size of each buffer
+    std::vector<size_t> chunk_rows(chunks.size());
+    if (chunks.size() == 1) {
+        chunk_rows[0] = countRows(chunks[0]);
+    }
+    else {
+        std::vector<std::future<size_t>> counting;
+        for (std::string_view chunk : chunks) {
+            counting.push_back(pool.submit([chunk]() { return countRows(chunk); }));
+        }
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            chunk_rows[i] = counting[i].get();
+        }
+    }
+    size_t row_count = 0;
+    for (size_t rows : chunk_rows) {
+        row_count += rows;
+    }
+
+    TypedCsv csv;
+    csv.rowCount = row_count;
+    csv.columns.resize(schema.size());
+    for (size_t col_idx = 0; col_idx < schema.size(); ++col_idx) {
+        TypedColumn& column = csv.columns[col_idx];
+        column.type = schema[col_idx];
+        if (column.type == ColumnType::Numeric) {
+            column.values.resize(row_count);
+        }
+        else if (column.type == ColumnType::Timestamp) {
+            column.epochs.resize(row_count);
+        }
+    }
+
+    // Columns past the last one we store are never tokenized
+    size_t last_stored_col = 0;
+    for (size_t col_idx = 0; col_idx < schema.size(); ++col_idx) {
+        if (schema[col_idx] != ColumnType::Skip) {
+            last_stored_col = col_idx + 1;
+        }
+    }
+
+    // Each chunk fills its own row range of the shared buffers, so no stitching is needed
+    std::vector<ChunkErrors> chunk_errors;
+    if (chunks.size() == 1) {
+        chunk_errors.push_back(parseTypedRows(chunks[0], 0, last_stored_col, delimiter, timestampFormat, csv));
+    }
+    else {
+        std::vector<std::future<ChunkErrors>> parsing;
+        size_t first_row = 0;
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            std::string_view chunk = chunks[i];
+            parsing.push_back(pool.submit([chunk, first_row, last_stored_col, delimiter, timestampFormat, &csv]() {
+                return parseTypedRows(chunk, first_row, last_stored_col, delimiter, timestampFormat, csv);
+            }));
+            first_row += chunk_rows[i];
+        }
+        for (auto& result : parsing) {
+            chunk_errors.push_back(result.get());
+        }
+    }
+    // Chunks are in file order, so appending their bad rows keeps the lists sorted
+    for (const ChunkErrors& errors : chunk_errors) {
+        for (size_t col_idx = 0; col_idx < errors.counts.size(); ++col_idx) {
+            csv.columns[col_idx].errorCount += errors.counts[col_idx];
+            csv.columns[col_idx].badRows.insert(csv.columns[col_idx].badRows.end(),
+                errors.badRows[col_idx].begin(), errors.badRows[col_idx].end());
+        }
+    }
+
+    return csv;
+}
\ No newline at end of file
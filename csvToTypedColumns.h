@@ -0,0 +1,51 @@
+// csvToTypedColumns.h
+#ifndef CSV_TO_TYPED_COLUMNS_H
+#define CSV_TO_TYPED_COLUMNS_H
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include "timestampParser.h"
+
+// How a CSV column is parsed by readCsvTyped.
+enum class ColumnType
+{
+    Skip,      // Not stored
+    Timestamp, // Parsed with TimestampParser, stored as seconds since 1970-01-01 00:00 UTC
+    Numeric    // Stored as double
+};
+
+// One parsed column. Only the buffer matching its type is filled, with one entry per row.
+struct TypedColumn
+{
+    ColumnType type = ColumnType::Skip;
+    std::vector<double> values;       // Numeric: NaN where the cell is missing or not a number
+    std::vector<std::int64_t> epochs; // Timestamp: 0 where the cell is missing or malformed
+    size_t errorCount = 0;            // Cells that were missing or failed to parse
+    std::vector<size_t> badRows;      // Timestamp: indices of those rows, in increasing order
+};
+
+// CSV data parsed straight into typed, column-major buffers.
+struct TypedCsv
+{
+    std::vector<TypedColumn> columns; // One entry per schema column
+    size_t rowCount = 0;
+
+    bool empty() const { return rowCount == 0; }
+};
+
+// Reads a CSV file in a single pass, writing every field directly into a preallocated typed
+// column. Column i of the file is parsed as schema[i]; columns beyond the schema are skipped.
+// With threadCount other than 1 the file is split at line boundaries and the chunks are parsed
+// in parallel (0 uses every core), each into its own row range of the buffers.
+// Timestamp columns are expected in timestampFormat.
+TypedCsv readCsvTyped(const std::string& filename, const std::vector<ColumnType>& schema, char delimiter = ',',
+    size_t threadCount = 1, TimestampFormat timestampFormat = TimestampFormat::DayMonthYearMinutes);
+
+// Same as readCsvTyped, for CSV text already in memory (without a byte order mark), e.g. the
+// lines appended to a file since it was last read.
+TypedCsv parseCsvTyped(std::string_view text, const std::vector<ColumnType>& schema, char delimiter = ',',
+    size_t threadCount = 1, TimestampFormat timestampFormat = TimestampFormat::DayMonthYearMinutes);
+
+#endif // CSV_TO_TYPED_COLUMNS_H
\ No newline at end of file
@@ -0,0 +1,85 @@
+// dayBoundaries.cpp
+#include "dayBoundaries.h"
+#include <QDateTime>
+#include <QTimeZone>     // Required for QTimeZone::UTC
+#include <cmath>         // Required for std::floor, std::isnan
+#include <limits>        // Required for std::numeric_limits<double>::quiet_NaN()
+
+namespace {
+
+const double SecondsPerDay = 86400.0; // UTC has no DST, so midnights are exact multiples of this
+
+// Closer than this, the lines would merge into a solid band and are left out
+const double MinLineSpacing = 3.0;
+
+} // namespace
+
+DayBoundaries::DayBoundaries(QCPAxis* keyAxis)
+    : QCPLayerable(keyAxis->parentPlot()),
+    mKeyAxis(keyAxis),
+    mFirstKey(std::numeric_limits<double>::quiet_NaN()),
+    mLastKey(std::numeric_limits<double>::quiet_NaN()),
+    mPen(Qt::red, 1, Qt::DashLine),
+    mFont(keyAxis->parentPlot()->font().family(), 9, QFont::Bold)
+{
+}
+
+void DayBoundaries::setDataSpan(double firstKey, double lastKey)
+{
+    mFirstKey = firstKey;
+    mLastKey = lastKey;
+}
+
+QRect DayBoundaries::clipRect() const
+{
+    return mKeyAxis ? mKeyAxis->axisRect()->rect() : QCPLayerable::clipRect();
+}
+
+void DayBoundaries::applyDefaultAntialiasingHint(QCPPainter* painter) const
+{
+    applyAntialiasingHint(painter, mAntialiased, QCP::aeItems);
+}
+
+void DayBoundaries::draw(QCPPainter* painter)
+{
+    if (!mKeyAxis || std::isnan(mFirstKey) || std::isnan(mLastKey)) {
+        return;
+    }
+
+    // Only midnights after the first sample's day started and within the view
+    const QCPRange range = mKeyAxis->range();
+    const double from = qMax(range.lower, mFirstKey);
+    const double to = qMin(range.upper, mLastKey);
+    double midnight = (std::floor(from / SecondsPerDay) + 1.0) * SecondsPerDay;
+    if (midnight > to) {
+        return;
+    }
+
+    const double spacing = qAbs(mKeyAxis->coordToPixel(SecondsPerDay) - mKeyAxis->coordToPixel(0.0));
+    if (spacing < MinLineSpacing) {
+        return;
+    }
+
+    const QRect rect = mKeyAxis->axisRect()->rect();
+    const double firstMidnight = midnight;
+    QVector<QLineF> lines;
+    for (; midnight <= to; midnight += SecondsPerDay) {
+        const double x = mKeyAxis->coordToPixel(midnight);
+        lines.append(QLineF(x, rect.top(), x, rect.bottom()));
+    }
+    painter->setPen(mPen);
+    painter->drawLines(lines);
+
+    // Labels only when there is room for them between two lines
+    const QTimeZone utc(QTimeZone::UTC); // Same clock as the parsed timestamps and the axis ticker
+    painter->setFont(mFont);
+    painter->setPen(QPen(Qt::red));
+    for (int i = 0; i < lines.size(); ++i) {
+        const qint64 secs = static_cast<qint64>(firstMidnight + i * SecondsPerDay);
+        const QString text = QDateTime::fromSecsSinceEpoch(secs, utc).date().toString("MMM dd");
+        if (i == 0 && spacing < painter->fontMetrics().horizontalAdvance(text) + 10) {
+            break;
+        }
+        painter->drawText(QPointF(lines[i].x1() + 5, rect.top() + 15), text);
+    }
+}
\ No newline at end of file
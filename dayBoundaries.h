@@ -0,0 +1,35 @@
+// dayBoundaries.h
+#ifndef DAY_BOUNDARIES_H
+#define DAY_BOUNDARIES_H
+
+#include <QPointer>
+#include <QPen>
+#include <QFont>
+#include "qcustomplot.h"
+
+// Dashed line and date label at every UTC midnight inside the logged time span of a plot. The
+// midnights are computed from the visible key range on every draw, so one object serves any
+// number of days, and the lines always run across the whole axis rect whatever the value range.
+class DayBoundaries : public QCPLayerable
+{
+public:
+    // Owned by the key axis' plot; draws nothing until setDataSpan is called.
+    explicit DayBoundaries(QCPAxis* keyAxis);
+
+    // Time of the first and last sample (seconds since epoch); midnights outside are not marked.
+    void setDataSpan(double firstKey, double lastKey);
+
+protected:
+    QRect clipRect() const override;
+    void applyDefaultAntialiasingHint(QCPPainter* painter) const override;
+    void draw(QCPPainter* painter) override;
+
+private:
+    QPointer<QCPAxis> mKeyAxis;
+    double mFirstKey;
+    double mLastKey;
+    QPen mPen;
+    QFont mFont;
+};
+
+#endif // DAY_BOUNDARIES_H
\ No newline at end of file
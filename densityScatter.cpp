@@ -0,0 +1,115 @@
+// densityScatter.cpp
+#include "densityScatter.h"
+#include <cmath>     // Required for std::isnan
+#include <vector>    // Required for std::vector
+
+namespace {
+
+// Colour map that only ever covers the current view, so it must not take part in axis rescaling:
+// the ranges come from the scatter graph's points.
+class DensityMap : public QCPColorMap
+{
+public:
+    DensityMap(QCPAxis* keyAxis, QCPAxis* valueAxis) : QCPColorMap(keyAxis, valueAxis) {}
+
+    QCPRange getKeyRange(bool& foundRange, QCP::SignDomain) const override
+    {
+        foundRange = false;
+        return QCPRange();
+    }
+
+    QCPRange getValueRange(bool& foundRange, QCP::SignDomain, const QCPRange&) const override
+    {
+        foundRange = false;
+        return QCPRange();
+    }
+};
+
+} // namespace
+
+DensityScatter::DensityScatter(QCPGraph* graph, int threshold)
+    : QObject(graph),
+    mGraph(graph),
+    mMap(new DensityMap(graph->keyAxis(), graph->valueAxis())),
+    mThreshold(threshold),
+    mBinnedCount(-1)
+{
+    QCPColorGradient gradient(QCPColorGradient::gpThermal);
+    gradient.setNanHandling(QCPColorGradient::nhTransparent); // Empty cells
+    mMap->setGradient(gradient);
+    mMap->setDataScaleType(QCPAxis::stLogarithmic); // A few outliers stay visible next to dense clusters
+    mMap->setInterpolate(false);
+    mMap->setSelectable(QCP::stNone);
+    mMap->removeFromLegend();
+    mMap->setVisible(false);
+
+    connect(graph->parentPlot(), &QCustomPlot::afterLayout, this, &DensityScatter::updateMap);
+}
+
+// Runs between layout and drawing of every replot, when the axis rect size is final
+void DensityScatter::updateMap()
+{
+    const int count = mGraph->dataCount();
+    const bool dense = count > mThreshold;
+    mGraph->setVisible(!dense);
+    mMap->setVisible(dense);
+    if (!dense) {
+        return;
+    }
+
+    const QCPRange keyRange = mGraph->keyAxis()->range();
+    const QCPRange valueRange = mGraph->valueAxis()->range();
+    const QSize size = mGraph->keyAxis()->axisRect()->size();
+    if (count == mBinnedCount && size == mBinnedSize && keyRange == mBinnedKeyRange && valueRange == mBinnedValueRange) {
+        return; // Nothing moved since the last replot
+    }
+
+    const int width = qMax(size.width(), 1);
+    const int height = qMax(size.height(), 1);
+    const double keyScale = width / keyRange.size();
+    const double valueScale = height / valueRange.size();
+
+    // Keys are sorted, so only the visible slice of the data is walked
+    std::vector<int> counts(static_cast<size_t>(width) * height, 0);
+    int maxCount = 0;
+    const QSharedPointer<QCPGraphDataContainer> data = mGraph->data();
+    const QCPGraphDataContainer::const_iterator end = data->findEnd(keyRange.upper, false);
+    for (QCPGraphDataContainer::const_iterator it = data->findBegin(keyRange.lower, false); it != end; ++it) {
+        if (!valueRange.contains(it->value)) {
+            continue; // Also skips NaN
+        }
+        const int x = qMin(static_cast<int>((it->key - keyRange.lower) * keyScale), width - 1);
+        const int y = qMin(static_cast<int>((it->value - valueRange.lower) * valueScale), height - 1);
+        maxCount = qMax(maxCount, ++counts[static_cast<size_t>(y) * width + x]);
+    }
+
+    // Cell centres sit half a cell inside the view, so the cells tile it exactly
+    QCPColorMapData* cells = mMap->data();
+    cells->setSize(width, height);
+    cells->setRange(QCPRange(keyRange.lower + 0.5 / keyScale, keyRange.upper - 0.5 / keyScale),
+        QCPRange(valueRange.lower + 0.5 / valueScale, valueRange.upper - 0.5 / valueScale));
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            const int n = counts[static_cast<size_t>(y) * width + x];
+            cells->setCell(x, y, n > 0 ? n : qQNaN());
+        }
+    }
+    mMap->setDataRange(QCPRange(1, qMax(maxCount, 2)));
+
+    mBinnedCount = count;
+    mBinnedSize = size;
+    mBinnedKeyRange = keyRange;
+    mBinnedValueRange = valueRange;
+}
+
+QVector<QCPGraphData> scatterPoints(const QVector<double>& keys, const QVector<double>& values)
+{
+    QVector<QCPGraphData> points;
+    points.reserve(keys.size());
+    for (int i = 0; i < keys.size(); ++i) {
+        if (!std::isnan(keys[i]) && !std::isnan(values[i])) {
+            points.append(QCPGraphData(keys[i], values[i]));
+        }
+    }
+    return points;
+}
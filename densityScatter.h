@@ -0,0 +1,45 @@
+// densityScatter.h
+#ifndef DENSITY_SCATTER_H
+#define DENSITY_SCATTER_H
+
+#include <QObject>
+#include <QSize>
+#include "qcustomplot.h"
+
+// Shows a scatter graph as a point-density map once it holds more points than can usefully be
+// drawn one symbol at a time. The visible points are counted into a 2D histogram with one cell
+// per screen pixel and drawn through a QCPColorMap (logarithmic colour scale, empty cells
+// transparent); below the threshold the graph draws its symbols as before. The graph keeps its
+// data in both modes, so setData/addData and axis rescaling work unchanged.
+class DensityScatter : public QObject
+{
+    Q_OBJECT
+
+public:
+    static const int DefaultThreshold = 100000;
+
+    // Owned by the graph; switches automatically whenever the plot is laid out for a replot.
+    explicit DensityScatter(QCPGraph* graph, int threshold = DefaultThreshold);
+
+    bool densityMode() const { return mMap->visible(); }
+
+private slots:
+    void updateMap();
+
+private:
+    QCPGraph* mGraph;
+    QCPColorMap* mMap;
+    int mThreshold;
+
+    // View and point count the map was last binned for; rebinning is skipped while they hold
+    QCPRange mBinnedKeyRange;
+    QCPRange mBinnedValueRange;
+    QSize mBinnedSize;
+    int mBinnedCount;
+};
+
+// Scatter points of two channels, without the rows where either is missing (or filtered out): a
+// NaN key has no place in the key-sorted container.
+QVector<QCPGraphData> scatterPoints(const QVector<double>& keys, const QVector<double>& values);
+
+#endif // DENSITY_SCATTER_H
\ No newline at end of file
@@ -0,0 +1,98 @@
+// derivedMetrics.cpp
+
+#include "derivedMetrics.h"
+#include "csvStructuralIndex.h" // Required for bestStructuralKernel (shared AVX2 detection)
+#include <limits>    // Required for std::numeric_limits<double>::quiet_NaN()
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define DERIVED_X86 1
+#include <immintrin.h>
+#endif
+
+// MSVC accepts AVX2 intrinsics in any function; GCC and Clang need the function to opt in
+#if defined(DERIVED_X86) && (defined(__GNUC__) || defined(__clang__))
+#define DERIVED_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define DERIVED_TARGET_AVX2
+#endif
+
+namespace {
+
+// The formulas keep the operation order of the original loops in main.cpp, so both kernels give
+// bit-identical results. A zero divisor selects NaN instead of the +-inf of the division.
+void computeScalar(const DerivedInputs& in, size_t begin, size_t count, double mcr, const DerivedOutputs& out)
+{
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    for (size_t i = begin; i < count; ++i) {
+        const double power = in.propPower[i];
+        const double foc = in.foc[i];
+        const double sog = in.sog ? in.sog[i] : 0.0;
+        const double sfoc = (foc * 1000000.0) / 24.0 / power;
+        const double fuel_per_mile = (foc * 1000.0) / 24.0 / sog;
+        out.engineLoad[i] = power / mcr * 100.0;
+        out.sfoc[i] = (power != 0.0) ? sfoc : nan;          // Compiles to a select, not a jump
+        if (out.fuelPerMile) {
+            out.fuelPerMile[i] = (sog != 0.0) ? fuel_per_mile : nan;
+        }
+    }
+}
+
+#ifdef DERIVED_X86
+
+DERIVED_TARGET_AVX2
+size_t computeAvx2(const DerivedInputs& in, size_t count, double mcr, const DerivedOutputs& out)
+{
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d nan = _mm256_set1_pd(std::numeric_limits<double>::quiet_NaN());
+    const __m256d mcr_v = _mm256_set1_pd(mcr);
+    const __m256d hundred = _mm256_set1_pd(100.0);
+    const __m256d grams_per_tonne = _mm256_set1_pd(1000000.0);
+    const __m256d kilograms_per_tonne = _mm256_set1_pd(1000.0);
+    const __m256d hours_per_day = _mm256_set1_pd(24.0);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m256d power = _mm256_loadu_pd(in.propPower + i);
+        const __m256d foc = _mm256_loadu_pd(in.foc + i);
+
+        const __m256d load = _mm256_mul_pd(_mm256_div_pd(power, mcr_v), hundred);
+        const __m256d sfoc = _mm256_div_pd(_mm256_div_pd(_mm256_mul_pd(foc, grams_per_tonne), hours_per_day), power);
+
+        // Lanes whose divisor is zero take NaN (ordered compare: a NaN divisor already gives NaN)
+        const __m256d power_zero = _mm256_cmp_pd(power, zero, _CMP_EQ_OQ);
+        _mm256_storeu_pd(out.engineLoad + i, load);
+        _mm256_storeu_pd(out.sfoc + i, _mm256_blendv_pd(sfoc, nan, power_zero));
+
+        if (out.fuelPerMile) {
+            const __m256d sog = _mm256_loadu_pd(in.sog + i);
+            const __m256d fuel_per_mile = _mm256_div_pd(_mm256_div_pd(_mm256_mul_pd(foc, kilograms_per_tonne), hours_per_day), sog);
+            const __m256d sog_zero = _mm256_cmp_pd(sog, zero, _CMP_EQ_OQ);
+            _mm256_storeu_pd(out.fuelPerMile + i, _mm256_blendv_pd(fuel_per_mile, nan, sog_zero));
+        }
+    }
+    return i;
+}
+
+#endif // DERIVED_X86
+
+} // namespace
+
+DerivedKernel bestDerivedKernel()
+{
+    // Same CPU check as the CSV tokenizer
+    static const DerivedKernel kernel = bestStructuralKernel() == StructuralKernel::Avx2 ? DerivedKernel::Avx2 : DerivedKernel::Scalar;
+    return kernel;
+}
+
+void computeDerivedMetrics(const DerivedInputs& in, size_t count, double mcr, const DerivedOutputs& out, DerivedKernel kernel)
+{
+    size_t done = 0;
+#ifdef DERIVED_X86
+    if (kernel == DerivedKernel::Avx2) {
+        done = computeAvx2(in, count, mcr, out);
+    }
+#else
+    (void)kernel;
+#endif
+    computeScalar(in, done, count, mcr, out); // Remaining rows
+}
\ No newline at end of file
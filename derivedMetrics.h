@@ -0,0 +1,38 @@
+// derivedMetrics.h
+#ifndef DERIVED_METRICS_H
+#define DERIVED_METRICS_H
+
+#include <cstddef>
+
+// Instruction set used to compute the derived channels.
+enum class DerivedKernel
+{
+    Scalar, // One row at a time
+    Avx2    // Four rows per step
+};
+
+// Fastest kernel supported by the CPU we are running on (detected once).
+DerivedKernel bestDerivedKernel();
+
+// Measured channels the derived ones are computed from, count values each.
+struct DerivedInputs
+{
+    const double* propPower = nullptr; // kW
+    const double* foc = nullptr;       // Fuel oil consumption, t/day
+    const double* sog = nullptr;       // Speed over ground, kn; only needed for fuelPerMile
+};
+
+// Buffers receiving the derived channels, count values each.
+struct DerivedOutputs
+{
+    double* engineLoad = nullptr;  // % of MCR
+    double* sfoc = nullptr;        // Specific fuel oil consumption, gr/kWh; NaN at zero power
+    double* fuelPerMile = nullptr; // kg per nautical mile over ground; NaN when not moving (optional)
+};
+
+// Computes every derived channel in one pass over the inputs. Rows where a quantity is undefined
+// (division by zero) get NaN without branching, so the plots leave a gap there.
+void computeDerivedMetrics(const DerivedInputs& in, size_t count, double mcr, const DerivedOutputs& out,
+    DerivedKernel kernel = bestDerivedKernel());
+
+#endif // DERIVED_METRICS_H
\ No newline at end of file
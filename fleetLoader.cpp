@@ -0,0 +1,163 @@
+// fleetLoader.cpp
+#include "fleetLoader.h"
+#include "threadPool.h"
+#include <QDir>
+#include <QFileInfo>
+#include <iostream>      // Required for std::cerr, std::endl
+#include <utility>       // Required for std::move
+
+namespace {
+
+void printUsage()
+{
+    std::cerr << "Usage: --fleet [--profile <vessel profile>] [--mcr kW] <directory | csv[=mcr]>..." << std::endl;
+}
+
+// The vessel's own profile if its log has one next to it, named after the profile if that gives a
+// name; mcr (when set) overrides the MCR. Vessels on the shared default keep their file's name
+bool addVessel(const QString& csvFile, const VesselProfile& defaultProfile, double mcr, std::vector<VesselLog>& vessels)
+{
+    const QFileInfo info(csvFile);
+    VesselLog vessel = { info.completeBaseName(), csvFile, defaultProfile };
+    const QString profileFile = info.dir().filePath(info.completeBaseName() + ".profile");
+    if (QFileInfo::exists(profileFile)) {
+        vessel.profile = VesselProfile();
+        if (!loadVesselProfile(profileFile.toStdString(), vessel.profile)) {
+            return false;
+        }
+        if (!vessel.profile.name.empty()) {
+            vessel.name = QString::fromStdString(vessel.profile.name);
+        }
+    }
+    if (mcr > 0.0) {
+        vessel.profile.mcr = mcr;
+    }
+    vessels.push_back(vessel);
+    return true;
+}
+
+} // namespace
+
+bool parseFleetArguments(const QStringList& arguments, const VesselProfile& defaultProfile, std::vector<VesselLog>& vessels)
+{
+    // --mcr applies to every vessel without a profile or MCR of its own, wherever it appears
+    VesselProfile profile = defaultProfile;
+    const int mcrIndex = arguments.indexOf("--mcr");
+    if (mcrIndex >= 0) {
+        bool valid = false;
+        profile.mcr = mcrIndex + 1 < arguments.size() ? arguments[mcrIndex + 1].toDouble(&valid) : 0.0;
+        if (!valid || profile.mcr <= 0.0) {
+            std::cerr << "Error: --mcr needs the engine's MCR in kW" << std::endl;
+            return false;
+        }
+    }
+
+    for (int i = 0; i < arguments.size(); ++i) {
+        const QString& argument = arguments[i];
+        if (argument == "--fleet") {
+            continue;
+        }
+        if (argument == "--mcr" || argument == "--profile") {
+            ++i; // Value already taken
+            continue;
+        }
+        if (argument.startsWith("--")) {
+            std::cerr << "Unknown option " << argument.toStdString() << std::endl;
+            printUsage();
+            return false;
+        }
+
+        QString path = argument;
+        double mcr = 0.0; // None of its own
+        const int separator = argument.lastIndexOf('=');
+        if (separator > 0) {
+            bool valid = false;
+            mcr = argument.mid(separator + 1).toDouble(&valid);
+            path = argument.left(separator);
+            if (!valid || mcr <= 0.0) {
+                std::cerr << "Error: Invalid MCR in '" << argument.toStdString() << "'" << std::endl;
+                return false;
+            }
+        }
+
+        const QFileInfo info(path);
+        if (info.isDir()) {
+            const QStringList csvFiles = QDir(path).entryList({ "*.csv" }, QDir::Files, QDir::Name);
+            for (const QString& csvFile : csvFiles) {
+                if (!addVessel(QDir(path).filePath(csvFile), profile, mcr, vessels)) {
+                    return false;
+                }
+            }
+        }
+        else if (info.isFile()) {
+            if (!addVessel(path, profile, mcr, vessels)) {
+                return false;
+            }
+        }
+        else {
+            std::cerr << "Warning: '" << path.toStdString() << "' does not exist, skipped" << std::endl;
+        }
+    }
+
+    if (vessels.empty()) {
+        std::cerr << "Error: No vessel logs found" << std::endl;
+        printUsage();
+        return false;
+    }
+    return true;
+}
+
+FleetLoader::FleetLoader(const std::vector<VesselLog>& vessels, Converter convert, QObject* parent)
+    : QObject(parent),
+    mVessels(vessels),
+    mConvert(std::move(convert)),
+    mCancelled(false),
+    mRemaining(static_cast<int>(vessels.size()))
+{
+    qRegisterMetaType<PlotDataset>("PlotDataset"); // Travels from the pool threads to the GUI thread
+}
+
+FleetLoader::~FleetLoader()
+{
+    mCancelled = true;
+    for (std::future<void>& task : mTasks) {
+        task.wait();
+    }
+}
+
+void FleetLoader::start()
+{
+    if (!mTasks.empty()) {
+        return;
+    }
+    ThreadPool& pool = ThreadPool::shared();
+    for (int i = 0; i < static_cast<int>(mVessels.size()); ++i) {
+        mTasks.push_back(pool.submit([this, i]() { load(i); }));
+    }
+}
+
+// Pool thread: signals are queued to the receivers on the GUI thread
+void FleetLoader::load(int index)
+{
+    if (!mCancelled) {
+        const VesselLog& vessel = mVessels[index];
+        const std::string csvFile = vessel.csvFile.toStdString();
+        ColumnLayout layout;
+        if (!resolveColumnLayout(vessel.profile, csvFile, layout)) {
+            emit vesselFailed(index, QString("Columns of the profile not found in '%1'").arg(vessel.csvFile));
+        }
+        else {
+            // Single-threaded parse: the task is itself on the pool and must not wait for other tasks
+            const ColumnTable rows = loadColumnTable(csvFile, layout.schema, vessel.profile.delimiter, 1, vessel.profile.timestampFormat);
+            if (rows.empty()) {
+                emit vesselFailed(index, QString("No data read from '%1' (missing, empty or unreadable)").arg(vessel.csvFile));
+            }
+            else {
+                emit vesselLoaded(index, mConvert(rows, vessel.profile, layout));
+            }
+        }
+    }
+    if (--mRemaining == 0) {
+        emit finished();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,68 @@
+// fleetLoader.h
+#ifndef FLEET_LOADER_H
+#define FLEET_LOADER_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <atomic>
+#include <functional>
+#include <future>
+#include <vector>
+#include "columnCache.h"
+#include "plotDataset.h"
+#include "vesselProfile.h"
+
+// One vessel of a fleet: its logger CSV and the profile (MCR, units, columns) it is read with.
+struct VesselLog
+{
+    QString name;
+    QString csvFile;
+    VesselProfile profile;
+};
+
+// Collects the vessels of fleet mode:
+//
+//   app --fleet [--profile <vessel profile>] [--mcr kW] <directory | csv[=mcr]>...
+//
+// A directory adds every *.csv in it. A vessel is read with the profile next to its log
+// (<csv base name>.profile) if there is one, and with defaultProfile otherwise; --mcr overrides the
+// MCR of defaultProfile, and an MCR after '=' that of the one file. Returns false, after printing
+// the usage, when nothing can be loaded.
+bool parseFleetArguments(const QStringList& arguments, const VesselProfile& defaultProfile, std::vector<VesselLog>& vessels);
+
+// Loads the logs of a fleet in parallel, one vessel per task on the shared thread pool. Each task
+// parses its file on its own thread (the cores are already busy with the other vessels), maps or
+// refreshes its column cache and keeps only the plot channels, so at most one raw column table
+// per core is alive at any time whatever the size of the fleet.
+class FleetLoader : public QObject
+{
+    Q_OBJECT
+
+public:
+    // Builds a vessel's plot channels from its parsed rows, laid out as its profile resolved against
+    // its file. Runs on the pool threads, several vessels at a time.
+    using Converter = std::function<PlotDataset(const ColumnTable& rows, const VesselProfile& profile, const ColumnLayout& layout)>;
+
+    FleetLoader(const std::vector<VesselLog>& vessels, Converter convert, QObject* parent = nullptr);
+    ~FleetLoader(); // Skips the vessels not started yet and waits for the running ones
+
+    void start();
+
+signals:
+    // Emitted from the pool threads in completion order; index is the vessel's position in the list.
+    void vesselLoaded(int index, const PlotDataset& dataset);
+    void vesselFailed(int index, const QString& reason);
+    void finished();
+
+private:
+    std::vector<VesselLog> mVessels;
+    Converter mConvert;
+    std::vector<std::future<void>> mTasks;
+    std::atomic<bool> mCancelled;
+    std::atomic<int> mRemaining;
+
+    void load(int index);
+};
+
+#endif // FLEET_LOADER_H
\ No newline at end of file
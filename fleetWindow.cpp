@@ -0,0 +1,167 @@
+// fleetWindow.cpp
+#include "fleetWindow.h"
+#include "densityScatter.h"
+#include <QGridLayout>   // For the small multiples
+#include <QVBoxLayout>   // For the overlay tab
+#include <QScrollArea>   // For scrolling through a large fleet
+#include <QTabWidget>    // For switching between overlay and small multiples
+#include <QStatusBar>    // For the loading count
+#include <QSharedPointer> // For QSharedPointer
+
+namespace {
+
+// Small multiples per row, and the smallest size at which one stays readable
+const int VesselPlotColumns = 4;
+const QSize VesselPlotSize(320, 240);
+
+// Shared SFOC vs load axes, so the small multiples compare at a glance
+const QCPRange LoadRange(0, 110);
+const QCPRange SfocRange(50, 300);
+
+// Neighbouring vessels get well separated hues (golden angle), whatever the fleet size
+QColor vesselColor(int index)
+{
+    return QColor::fromHsv((index * 137) % 360, 220, 200);
+}
+
+void stylePlot(QCustomPlot* plot, const QString& title, const QString& xAxisLabel, const QString& yAxisLabel, int titleSize)
+{
+    plot->setBackground(Qt::white);
+    plot->xAxis->grid()->setPen(QPen(QColor(192, 192, 192), 1, Qt::DotLine));
+    plot->yAxis->grid()->setPen(QPen(QColor(192, 192, 192), 1, Qt::DotLine));
+
+    plot->plotLayout()->insertRow(0);
+    plot->plotLayout()->addElement(0, 0, new QCPTextElement(plot, title, QFont("sans", titleSize, QFont::Bold)));
+
+    plot->xAxis->setLabel(xAxisLabel);
+    plot->yAxis->setLabel(yAxisLabel);
+    plot->setInteractions(QCP::iRangeDrag | QCP::iRangeZoom);
+}
+
+} // namespace
+
+FleetWindow::FleetWindow(const std::vector<VesselLog>& vessels, QWidget* parent)
+    : QMainWindow(parent), mVessels(vessels), mDatasets(vessels.size())
+{
+    setWindowTitle(QString("Marine Engine Efficiency Analyzer - Fleet of %1").arg(vessels.size()));
+    setMinimumSize(1200, 900);
+
+    QTabWidget* tabs = new QTabWidget(this);
+    setCentralWidget(tabs);
+
+    // --- Overlay: every vessel in the same two plots ---
+    QWidget* overlay = new QWidget(tabs);
+    QVBoxLayout* overlayLayout = new QVBoxLayout(overlay);
+
+    mLoadPlot = new QCustomPlot(overlay);
+    stylePlot(mLoadPlot, "Engine Load Over Time", "Time", "Engine Load (%)", 12);
+    QSharedPointer<QCPAxisTickerDateTime> dateTimeTicker(new QCPAxisTickerDateTime);
+    dateTimeTicker->setDateTimeFormat("dd/MM/yyyy\nHH:mm");
+    dateTimeTicker->setDateTimeSpec(Qt::UTC); // Timestamps are parsed as logger (UTC) time
+    mLoadPlot->xAxis->setTicker(dateTimeTicker);
+    mLoadPlot->legend->setVisible(true);
+    mLoadPlot->legend->setFont(QFont(font().family(), 7));
+    mLoadPlot->legend->setBrush(QBrush(QColor(255, 255, 255, 150)));
+    overlayLayout->addWidget(mLoadPlot);
+
+    mSfocPlot = new QCustomPlot(overlay);
+    stylePlot(mSfocPlot, "SFOC vs. Engine Load", "Engine Load (%)", "SFOC (gr/kWh)", 12);
+    mSfocPlot->xAxis->setRange(LoadRange);
+    mSfocPlot->yAxis->setRange(SfocRange);
+    overlayLayout->addWidget(mSfocPlot);
+
+    for (int i = 0; i < static_cast<int>(mVessels.size()); ++i) {
+        QCPColumnGraph* loadGraph = new QCPColumnGraph(mLoadPlot->xAxis, mLoadPlot->yAxis);
+        loadGraph->setName(mVessels[i].name);
+        loadGraph->setPen(QPen(vesselColor(i)));
+        mLoadGraphs.append(loadGraph);
+
+        // Dots: with dozens of vessels on top of each other, symbols would hide the shape of each cloud
+        QCPGraph* sfocGraph = mSfocPlot->addGraph();
+        sfocGraph->setPen(QPen(vesselColor(i)));
+        sfocGraph->setLineStyle(QCPGraph::lsNone);
+        sfocGraph->setScatterStyle(QCPScatterStyle(QCPScatterStyle::ssDot));
+        mSfocGraphs.append(sfocGraph);
+    }
+    tabs->addTab(overlay, "Overlay");
+
+    // --- Small multiples: one SFOC vs load plot per vessel ---
+    QScrollArea* scroll = new QScrollArea(tabs);
+    QWidget* grid = new QWidget(scroll);
+    QGridLayout* gridLayout = new QGridLayout(grid);
+    for (int i = 0; i < static_cast<int>(mVessels.size()); ++i) {
+        gridLayout->addWidget(addVesselPlot(i), i / VesselPlotColumns, i % VesselPlotColumns);
+    }
+    scroll->setWidget(grid);
+    scroll->setWidgetResizable(true);
+    tabs->addTab(scroll, "Per vessel");
+
+    showProgress();
+}
+
+QCustomPlot* FleetWindow::addVesselPlot(int index)
+{
+    const VesselLog& vessel = mVessels[index];
+    QCustomPlot* plot = new QCustomPlot;
+    plot->setMinimumSize(VesselPlotSize);
+    stylePlot(plot, QString("%1 (MCR %2 kW)").arg(vessel.name).arg(vessel.profile.mcr), "Engine Load (%)", "SFOC (gr/kWh)", 9);
+    plot->xAxis->setRange(LoadRange);
+    plot->yAxis->setRange(SfocRange);
+
+    QCPGraph* graph = plot->addGraph();
+    graph->setPen(QPen(vesselColor(index)));
+    graph->setLineStyle(QCPGraph::lsNone);
+    graph->setScatterStyle(QCPScatterStyle(QCPScatterStyle::ssCircle, 3));
+    new DensityScatter(graph); // Owned by the graph; long logs are drawn as a density map
+    mVesselPlots.append(plot);
+    return plot;
+}
+
+void FleetWindow::trackLoading(FleetLoader* loader)
+{
+    connect(loader, &FleetLoader::vesselLoaded, this, &FleetWindow::addVessel);
+    connect(loader, &FleetLoader::vesselFailed, this, &FleetWindow::markFailed);
+}
+
+void FleetWindow::addVessel(int index, const PlotDataset& dataset)
+{
+    mDatasets[index] = dataset; // Shares the channel buffers with the loader's copy
+    const PlotDataset& vessel = mDatasets[index];
+
+    mLoadGraphs[index]->setColumns(vessel.channel(PlotDataset::Time).constData(),
+        vessel.channel(PlotDataset::EngineLoad).constData(), vessel.rowCount());
+    // The overlay and the vessel's own plot share one copy of the scatter points
+    mSfocGraphs[index]->data()->set(scatterPoints(vessel.channel(PlotDataset::EngineLoad), vessel.channel(PlotDataset::Sfoc)));
+    mVesselPlots[index]->graph(0)->setData(mSfocGraphs[index]->data());
+
+    mLoadPlot->rescaleAxes();
+    mLoadPlot->replot(QCustomPlot::rpQueuedReplot); // Vessels finishing together share one replot
+    mSfocPlot->replot(QCustomPlot::rpQueuedReplot);
+    mVesselPlots[index]->replot(QCustomPlot::rpQueuedReplot);
+
+    ++mLoadedCount;
+    showProgress();
+}
+
+// The reason is reported on the console by whoever started the loader
+void FleetWindow::markFailed(int index)
+{
+    mLoadGraphs[index]->removeFromLegend();
+    if (QCPTextElement* title = qobject_cast<QCPTextElement*>(mVesselPlots[index]->plotLayout()->element(0, 0))) {
+        title->setText(mVessels[index].name + " - not loaded");
+        title->setTextColor(Qt::red);
+    }
+    mVesselPlots[index]->replot(QCustomPlot::rpQueuedReplot);
+
+    ++mFailedCount;
+    showProgress();
+}
+
+void FleetWindow::showProgress()
+{
+    QString message = QString("Loaded %1 of %2 vessels").arg(mLoadedCount).arg(mVessels.size());
+    if (mFailedCount > 0) {
+        message += QString(", %1 failed").arg(mFailedCount);
+    }
+    statusBar()->showMessage(message);
+}
\ No newline at end of file
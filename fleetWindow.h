@@ -0,0 +1,46 @@
+// fleetWindow.h
+#ifndef FLEET_WINDOW_H
+#define FLEET_WINDOW_H
+
+#include <QMainWindow>
+#include <QVector>
+#include <vector>
+#include "qcustomplot.h"
+#include "plotDataset.h"
+#include "fleetLoader.h"
+
+// Compares the vessels of a fleet: engine load over time and SFOC vs engine load with every
+// vessel overlaid in its own colour, and one small SFOC vs load plot per vessel on common axes.
+// Vessels appear as they finish loading.
+class FleetWindow : public QMainWindow
+{
+    Q_OBJECT
+
+public:
+    explicit FleetWindow(const std::vector<VesselLog>& vessels, QWidget* parent = nullptr);
+
+    // Shows the loader's vessels as they arrive, with the count loaded in the status bar.
+    void trackLoading(FleetLoader* loader);
+
+private slots:
+    void addVessel(int index, const PlotDataset& dataset);
+    void markFailed(int index);
+
+private:
+    std::vector<VesselLog> mVessels;
+    std::vector<PlotDataset> mDatasets; // One per vessel, never resized: the load graphs read them in place
+
+    QCustomPlot* mLoadPlot;
+    QCustomPlot* mSfocPlot;
+    QVector<QCPColumnGraph*> mLoadGraphs;
+    QVector<QCPGraph*> mSfocGraphs;
+    QVector<QCustomPlot*> mVesselPlots;
+
+    int mLoadedCount = 0;
+    int mFailedCount = 0;
+
+    QCustomPlot* addVesselPlot(int index);
+    void showProgress();
+};
+
+#endif // FLEET_WINDOW_H
\ No newline at end of file
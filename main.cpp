@@ -1,177 +1,211 @@
 // main.cpp
 
-#include "csvIntoColumns.h" 
-#include "stringToFloatVector.h"
+#include "batchReport.h"
+#include "columnCache.h"
+#include "csvFollower.h"
+#include "csvLoader.h"
+#include "fleetLoader.h"
+#include "fleetWindow.h"
 #include "mainwindow.h"
+#include "plotDataset.h"
+#include "vesselProfile.h"
 #include <QApplication>
-#include <QVector>       // Required for QVector
+#include <QtGlobal>      // Required for qputenv, qEnvironmentVariableIsEmpty
 #include <QDateTime>     // Required for QDateTime for timestamp parsing
 #include <QDebug>        // Required for qDebug() for debugging output
-#include <iostream>      // Required for std::cerr, std::endl
 #include <algorithm>     // Required for std::min
-#include <limits>        // Required for std::numeric_limits<float>::quiet_NaN()
-
-int main(int argc, char* argv[])
+#include <iostream>      // Required for std::cerr, std::endl
+#include <vector>        // Required for std::vector
+
+// Channels the plots are built from, taken from a block of logger rows laid out as the vessel's
+// profile says and converted to the plots' units. Engine Load % (against the vessel's MCR) and SFOC
+// in gr/kWh [FOC/PropPower] are derived in the same pass, and the rows flagged steady or transient
+// by the detector (which continues from the blocks before). firstRow is the block's first row in
+// the file, so the header line is left out
+PlotDataset toDataset(const ColumnTable& rows, size_t firstRow, const VesselProfile& profile, const ColumnLayout& layout,
+    SteadyStateDetector& steady)
 {
-    QApplication a(argc, argv); // Create the QApplication instance
-
-    const std::string datapointsFilename = "Book1.csv";
-
-    // Read the CSV data into a column-major format
-    std::vector<std::vector<std::string>> dataPoints = readCsv(datapointsFilename);
-
-    // Basic error checking if CSV reading failed or returned empty data
-    if (dataPoints.empty()) {
-        std::cerr << "Error: No data read from CSV or file not found. Exiting." << std::endl;
-        return 1;
-    }
-
-    // Ensure the CSV has at least 11 columns as expected for your data
-    if (dataPoints.size() < 11) {
-        std::cerr << "Error: CSV file does not contain enough columns. Expected at least 11, got " << dataPoints.size() << ". Exiting." << std::endl;
-        return 1;
-    }
-
-    // --- Data Extraction and Conversion ---
-    // 1. Extract and convert timestamps for plot's X-axis
-    QVector<double> plot_time_data; // Will hold QDateTime::toSecsSinceEpoch() values
-    QVector<QString> timeUI_qstring_labels; // Will hold original QString labels (for debugging/optional use)
-
-    // Check if the timestamp column has data beyond the header
-    if (dataPoints[0].size() > 1) {
-        for (size_t i = 0; i < dataPoints[0].size(); ++i) { // Start from 0 (no header)
-            QString dateTimeString = QString::fromStdString(dataPoints[0][i]).trimmed();
-
-            QDateTime dateTime = QDateTime::fromString(dateTimeString, "dd/MM/yyyy HH:mm");
-
-            if (!dateTime.isValid()) {
-                qDebug() << "ERROR: Failed to parse datetime string:" << dateTimeString;
-                qDebug() << "  Expected format: dd/MM/yyyy HH:mm (e.g., 08/03/2021 10:29)";
-                plot_time_data.push_back(0.0); // Push 0.0 for invalid dates (epoch start)
-            }
-            else {
-                plot_time_data.push_back(dateTime.toSecsSinceEpoch()); 
-            }
-            timeUI_qstring_labels.push_back(dateTimeString); // Store for labels parameter
+    const size_t skipped = firstRow < layout.headerLines ? std::min(layout.headerLines - firstRow, rows.rowCount()) : 0;
+    const size_t count = rows.rowCount() - skipped;
+
+    // Channels logged in other units are scaled into scratch buffers; the rest are read in place
+    std::vector<std::vector<double>> scaled;
+    scaled.reserve(static_cast<size_t>(LoggerChannel::Count));
+    auto values = [&](LoggerChannel channel, double factor) {
+        const size_t column = layout.channelColumns[static_cast<size_t>(channel)];
+        if (column == ColumnLayout::NotLogged) {
+            return static_cast<const double*>(nullptr);
         }
-    }
-    else {
-        std::cerr << "Warning: Time column (Column 0) is empty or only contains a header. No X-axis data for plot 1." << std::endl;
-    }
-
-    // Declare and populate std::vector<std::string> for each column, skipping the header (index 0)
-    std::vector<std::string> SOG_str, STW_str, PropPower_str, PropRev_str, FOC_str,
-        Tmean_str, Trim_str, ShipHeadingDeg_str, RelWindDirDeg_str, RelWindSpeed_str;
-
-    // Helper lambda for cleaner column extraction
-    auto extractColumn = [&](std::vector<std::string>& dest, size_t colIdx) {
-        if (dataPoints.size() > colIdx && dataPoints[colIdx].size() > 1) {
-            for (size_t i = 0; i < dataPoints[colIdx].size(); ++i) { // Start from 0 (no header)
-                dest.push_back(dataPoints[colIdx][i]);
-            }
+        const double* in = rows.values(column) + skipped;
+        if (factor == 1.0) {
+            return in;
         }
-        else {
-            std::cerr << "Warning: Column " << colIdx + 1 << " is empty or only contains a header." << std::endl;
+        scaled.emplace_back(in, in + count);
+        for (double& value : scaled.back()) {
+            value *= factor;
+        }
+        return static_cast<const double*>(scaled.back().data());
+    };
+
+    LoggerChannels channels;
+    channels.time = rows.epochs(layout.channelColumns[static_cast<size_t>(LoggerChannel::Time)]) + skipped; // Logger clock taken as UTC
+    channels.sog = values(LoggerChannel::Sog, profile.speedToKnots);
+    channels.stw = values(LoggerChannel::Stw, profile.speedToKnots);
+    channels.propPower = values(LoggerChannel::PropPower, profile.powerToKilowatts);
+    channels.propRev = values(LoggerChannel::PropRev, 1.0);
+    channels.foc = values(LoggerChannel::Foc, profile.focToTonnesPerDay);
+    channels.relWindDir = values(LoggerChannel::RelWindDir, 1.0);
+    channels.relWindSpeed = values(LoggerChannel::RelWindSpeed, profile.windSpeedToMetresPerSecond);
+    return PlotDataset::fromLogger(channels, count, profile.mcr, steady);
+}
+
+// Reports missing or malformed cells of a block of rows (those cells hold NaN, or 0 for
+// timestamps). firstRow is the block's first row in the file; reportedTimeErrors counts the
+// invalid datetimes seen so far, so only the first few are listed. The header line's cells are
+// text and not counted
+void reportBadCells(const ColumnTable& rows, size_t firstRow, const ColumnLayout& layout, size_t& reportedTimeErrors)
+{
+    const size_t headerRows = firstRow < layout.headerLines ? std::min(layout.headerLines - firstRow, rows.rowCount()) : 0;
+    for (size_t colIdx = 0; colIdx < rows.columnCount(); ++colIdx) {
+        const size_t errors = rows.type(colIdx) == ColumnType::Skip ? 0 : rows.errorCount(colIdx) - std::min(headerRows, rows.errorCount(colIdx));
+        if (errors > 0) {
+            std::cerr << "Warning: Column " << colIdx + 1 << " has " << errors
+                << " missing or malformed cells in lines " << firstRow + 1 << "-" << firstRow + rows.rowCount() << "." << std::endl;
         }
-        };
-
-    extractColumn(SOG_str, 1);           // SOG (Column 2)
-    extractColumn(STW_str, 2);           // STW (Column 3)
-    extractColumn(PropPower_str, 3);     // PropPower (Column 4)
-    extractColumn(PropRev_str, 4);       // PropRev (Column 5)
-    extractColumn(FOC_str, 5);           // FOC (Column 6)
-    extractColumn(Tmean_str, 6);         // Tmean (Column 7)
-    extractColumn(Trim_str, 7);          // Trim (Column 8)
-    extractColumn(ShipHeadingDeg_str, 8); // ShipHeadingDeg (Column 9)
-    extractColumn(RelWindDirDeg_str, 9); // RelWindDirDeg (Column 10)
-    extractColumn(RelWindSpeed_str, 10); // RelWindSpeed (Column 11)
-
-
-    // Convert string vectors to float vectors
-    std::vector<float> SOG_float = convertStringVectorToFloatVector(SOG_str);
-    std::vector<float> STW_float = convertStringVectorToFloatVector(STW_str);
-    std::vector<float> PropPower_float = convertStringVectorToFloatVector(PropPower_str);
-    std::vector<float> PropRev_float = convertStringVectorToFloatVector(PropRev_str);
-    std::vector<float> FOC_float = convertStringVectorToFloatVector(FOC_str);
-    std::vector<float> Tmean_float = convertStringVectorToFloatVector(Tmean_str);
-    std::vector<float> Trim_float = convertStringVectorToFloatVector(Trim_str);
-    std::vector<float> ShipHeadingDeg_float = convertStringVectorToFloatVector(ShipHeadingDeg_str);
-    std::vector<float> RelWindDirDeg_float = convertStringVectorToFloatVector(RelWindDirDeg_str);
-    std::vector<float> RelWindSpeed_float = convertStringVectorToFloatVector(RelWindSpeed_str);
-
-    // Calculate Engine Load % (MCR = 9930 kW)
-    std::vector<float> EngineLoad_float;
-    float MCR = 9930.0f;
-    EngineLoad_float.reserve(PropPower_float.size());
-    for (size_t i = 0; i < PropPower_float.size(); ++i) {
-        EngineLoad_float.push_back(PropPower_float[i] / MCR * 100.0f); // Convert to percentage
     }
 
-    // Calculate SFOC in gr/kWh [FOC/PropPower]
-    std::vector<float> SFOC_float;
-    SFOC_float.reserve(PropPower_float.size());
-    size_t common_data_size = std::min(PropPower_float.size(), FOC_float.size());
-
-    for (size_t i = 0; i < common_data_size; ++i) {
-        if (PropPower_float[i] != 0.0f) {
-            SFOC_float.push_back((FOC_float[i] * 1000000.0f) / 24.0f / PropPower_float[i]);
+    const size_t maxReported = 20; // Keep the log readable for badly damaged files
+    for (size_t badRow : rows.badRows(layout.channelColumns[static_cast<size_t>(LoggerChannel::Time)])) {
+        if (badRow < headerRows) {
+            continue;
         }
-        else {
-            SFOC_float.push_back(std::numeric_limits<float>::quiet_NaN()); // Use NaN for undefined values
+        if (reportedTimeErrors < maxReported) {
+            qDebug() << "ERROR: Failed to parse datetime on line" << firstRow + badRow + 1;
         }
+        if (reportedTimeErrors == 0) {
+            qDebug() << "  Expected the format given by the vessel profile (default dd/MM/yyyy HH:mm, e.g., 08/03/2021 10:29)";
+        }
+        ++reportedTimeErrors;
     }
+}
 
+int main(int argc, char* argv[])
+{
+    // Report mode renders without a display; the platform has to be picked before the application exists
+    if (isReportMode(argc, argv) && qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
 
-    // --- Prepare data for QCustomPlot (QVector<double>) for all 5 plots ---
-    int data_points_count = plot_time_data.size(); // Use this as the common size
+    QApplication a(argc, argv); // Create the QApplication instance
 
-    // Plot 1: Engine Load Over Time (EngineLoad vs Time)
-    QVector<double> plot1_y_engine_load(data_points_count); 
-    for (int i = 0; i < data_points_count; ++i) {
-        plot1_y_engine_load[i] = (i < EngineLoad_float.size()) ? static_cast<double>(EngineLoad_float[i]) : 0.0;
-    }
+    const std::string datapointsFilename = "Book1.csv";
 
-    // Plot 2: SFOC vs. Engine Load
-    QVector<double> plot2_x_engine_load(data_points_count);
-    QVector<double> plot2_y_sfoc(data_points_count);
-    for (int i = 0; i < data_points_count; ++i) {
-        plot2_x_engine_load[i] = (i < EngineLoad_float.size()) ? static_cast<double>(EngineLoad_float[i]) : 0.0;
-        plot2_y_sfoc[i] = (i < SFOC_float.size()) ? static_cast<double>(SFOC_float[i]) : 0.0;
+    // Vessel profile (--profile <file>): MCR, units and which CSV column holds which channel. The
+    // defaults describe the original logger: timestamp followed by ten numeric channels, no header
+    VesselProfile profile;
+    const int profileIndex = a.arguments().indexOf("--profile");
+    if (profileIndex >= 0) {
+        if (profileIndex + 1 >= a.arguments().size()) {
+            std::cerr << "Error: --profile needs a vessel profile file" << std::endl;
+            return 1;
+        }
+        if (!loadVesselProfile(a.arguments()[profileIndex + 1].toStdString(), profile)) {
+            return 1;
+        }
     }
 
-    // Plot 3: Speed Over Ground (SOG) & Speed Through Water (STW) Over Time
-    QVector<double> plot3_y_sog(data_points_count);
-    QVector<double> plot3_y_stw(data_points_count);
-    for (int i = 0; i < data_points_count; ++i) {
-        plot3_y_sog[i] = (i < SOG_float.size()) ? static_cast<double>(SOG_float[i]) : 0.0;
-        plot3_y_stw[i] = (i < STW_float.size()) ? static_cast<double>(STW_float[i]) : 0.0;
+    // Batch report (--report <output dir> [--pdf] [--jobs N] <csv>...): write the plots and exit
+    if (isReportMode(argc, argv)) {
+        ReportOptions options;
+        if (!parseReportArguments(a.arguments().mid(1), options)) {
+            return 1;
+        }
+        if (!options.worker) {
+            return runBatchReport(options);
+        }
+        return runReportWorker(options, profile, [&profile](const ColumnTable& rows, const ColumnLayout& layout) {
+            SteadyStateDetector steady;
+            return toDataset(rows, 0, profile, layout, steady);
+        });
     }
 
-    // Plot 4: Hull & Propeller Performance (SOG vs PropPower)
-    QVector<double> plot4_x_sog(data_points_count);
-    QVector<double> plot4_y_prop_power(data_points_count);
-    for (int i = 0; i < data_points_count; ++i) {
-        plot4_x_sog[i] = (i < SOG_float.size()) ? static_cast<double>(SOG_float[i]) : 0.0;
-        plot4_y_prop_power[i] = (i < PropPower_float.size()) ? static_cast<double>(PropPower_float[i]) : 0.0;
+    // Fleet mode (--fleet [--mcr kW] <directory | csv[=mcr]>...): all vessels side by side, loaded
+    // in parallel, each with its own profile
+    if (a.arguments().contains("--fleet")) {
+        std::vector<VesselLog> vessels;
+        if (!parseFleetArguments(a.arguments().mid(1), profile, vessels)) {
+            return 1;
+        }
+        // Declared before the window, so on exit the window goes first and the loader then waits
+        // for the vessels still loading
+        FleetLoader fleetLoader(vessels, [](const ColumnTable& rows, const VesselProfile& vesselProfile, const ColumnLayout& layout) {
+            SteadyStateDetector steady;
+            return toDataset(rows, 0, vesselProfile, layout, steady);
+        });
+        FleetWindow fleet(vessels);
+        fleet.trackLoading(&fleetLoader);
+        QObject::connect(&fleetLoader, &FleetLoader::vesselFailed, &fleet, [](int, const QString& reason) {
+            std::cerr << "Error: " << reason.toStdString() << std::endl;
+        });
+        fleet.show();
+        fleetLoader.start();
+        return a.exec();
     }
 
-    // Plot 5: Environmental Factors: Wind Speed & Direction
-    QVector<double> plot5_x_wind_dir(data_points_count);
-    QVector<double> plot5_y_wind_speed(data_points_count);
-    for (int i = 0; i < data_points_count; ++i) {
-        plot5_x_wind_dir[i] = (i < RelWindDirDeg_float.size()) ? static_cast<double>(RelWindDirDeg_float[i]) : 0.0;
-        plot5_y_wind_speed[i] = (i < RelWindSpeed_float.size()) ? static_cast<double>(RelWindSpeed_float[i]) : 0.0;
+    // Resolved once: only the columns the profile maps are parsed, the others are skipped by the tokenizer
+    ColumnLayout layout;
+    if (!resolveColumnLayout(profile, datapointsFilename, layout)) {
+        return 1;
     }
 
-    // Create an instance of our MainWindow, passing all the prepared data
-    MainWindow w(nullptr,
-        plot_time_data, plot1_y_engine_load, // Plot 1 data
-        plot2_x_engine_load, plot2_y_sfoc,                     // Plot 2 data
-        plot_time_data, plot3_y_sog, plot3_y_stw,             // Plot 3 data (using common time data)
-        plot4_x_sog, plot4_y_prop_power,                      // Plot 4 data
-        plot5_x_wind_dir, plot5_y_wind_speed                 // Plot 5 data
-        );
+    // Load in the background: the window comes up right away and fills in block by block. The
+    // binary column cache is mapped if it is up to date; otherwise the CSV is parsed straight into
+    // typed columns (in parallel on every core) and the cache refreshed for the next launch. The
+    // steady-state windows run on from block to block, and on into the rows of follow mode
+    size_t reportedTimeErrors = 0;
+    SteadyStateDetector steady;
+    CsvLoader* loader = new CsvLoader(QString::fromStdString(datapointsFilename), layout.schema, profile.delimiter,
+        profile.timestampFormat, [&reportedTimeErrors, &profile, &layout, &steady](const ColumnTable& rows, size_t firstRow) {
+            reportBadCells(rows, firstRow, layout, reportedTimeErrors);
+            return toDataset(rows, firstRow, profile, layout, steady);
+        });
+
+    MainWindow w; // Create an instance of our MainWindow
+    loader->setParent(&w);
+    w.trackLoading(loader);
     w.show(); // Display the main window
 
+    QObject::connect(loader, &CsvLoader::failed, &w, [](const QString& reason) {
+        std::cerr << "Error: " << reason.toStdString() << std::endl;
+    });
+    QObject::connect(loader, &CsvLoader::finished, &w, [&reportedTimeErrors](qint64) {
+        const size_t maxReported = 20;
+        if (reportedTimeErrors > maxReported) {
+            qDebug() << "  ..." << reportedTimeErrors - maxReported << "more lines with invalid datetimes";
+        }
+    });
+
+    // Follow mode (--follow): once loaded, keep reading the rows the logger appends to the CSV
+    if (a.arguments().contains("--follow")) {
+        QObject::connect(loader, &CsvLoader::finished, &w, [&w, &profile, &layout, &steady, &datapointsFilename](qint64 loadedBytes) {
+            CsvFollower* follower = new CsvFollower(QString::fromStdString(datapointsFilename), layout.schema, profile.delimiter,
+                profile.timestampFormat, static_cast<size_t>(loadedBytes), &w);
+
+            QObject::connect(follower, &CsvFollower::rowsAppended, &w, [&w, &profile, &layout, &steady](const TypedCsv& rows) {
+                // Only the new rows are converted and derived; the loaded history is left alone
+                const TypedColumn& time = rows.columns[layout.channelColumns[static_cast<size_t>(LoggerChannel::Time)]];
+                if (time.errorCount > 0) {
+                    qDebug() << "ERROR:" << time.errorCount << "appended lines have invalid datetimes";
+                }
+                // Appended rows come after the header, whatever their position
+                w.appendData(toDataset(ColumnTable::fromTypedCsv(rows), layout.headerLines, profile, layout, steady));
+            });
+            QObject::connect(follower, &CsvFollower::stopped, &w, [](const QString& reason) {
+                qDebug() << "Stopped following:" << reason;
+            });
+        });
+    }
+
+    loader->start();
     return a.exec(); // Start the Qt event loop
 }
\ No newline at end of file
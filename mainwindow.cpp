@@ -1,27 +1,43 @@
 // mainwindow.cpp
 #include "mainwindow.h"
+#include "densityScatter.h"
 #include <QGridLayout>      // For grid layout
 #include <QWidget>       // For setting a central widget
 #include <QSharedPointer> // For QSharedPointer
 #include <QDateTime>     // For QDateTime operations
 #include <QPalette>      // For setting background color
 #include <QColor>        // For QColor
+#include <QStatusBar>    // For the loading progress
+#include <QPushButton>   // For cancelling a load
+#include <QToolBar>      // For the steady-state filter
+#include <QAction>       // For the steady-state filter
+#include <QLabel>        // For the interval statistics
+#include <algorithm>     // For std::count, std::upper_bound
+#include <limits>        // For std::numeric_limits
+
+namespace {
+
+// The speed-power baseline is fitted over the first days of the log, taken as the clean-hull
+// reference period
+const double ReferenceDays = 30.0;
+const double SecondsPerDay = 86400.0;
+
+// First timestamp of the rows in time order, skipping the rows whose timestamp could not be read
+// (stored as 0, so sorted to the front); NaN if there is none
+double firstValidTime(const QVector<double>& time)
+{
+    const auto first = std::upper_bound(time.begin(), time.end(), 0.0);
+    return first == time.end() ? std::numeric_limits<double>::quiet_NaN() : *first;
+}
+
+} // namespace
 
 // Constructor receives all plot data
-MainWindow::MainWindow(QWidget* parent,
-    const QVector<double>& plot1_x_time,
-    const QVector<double>& plot1_y_engine_load,
-    const QVector<double>& plot2_x_engine_load,
-    const QVector<double>& plot2_y_sfoc,
-    const QVector<double>& plot3_x_time,
-    const QVector<double>& plot3_y_sog,
-    const QVector<double>& plot3_y_stw,
-    const QVector<double>& plot4_x_sog,
-    const QVector<double>& plot4_y_prop_power,
-    const QVector<double>& plot5_x_wind_dir,
-    const QVector<double>& plot5_y_wind_speed)
-    : QMainWindow(parent)
+MainWindow::MainWindow(QWidget* parent, PlotDataset dataset)
+    : QMainWindow(parent), mDataset(std::move(dataset))
 {
+    const QVector<double>& time = mDataset.channel(PlotDataset::Time);
+
     setWindowTitle("Marine Engine Efficiency Analyzer");
     setMinimumSize(1200, 900);
 
@@ -41,93 +57,387 @@ MainWindow::MainWindow(QWidget* parent,
     customPlot1 = new QCustomPlot(this);
     mainLayout->addWidget(customPlot1, 0, 0, 2, 1);
 
-    // Add graph for Engine Load, using the default yAxis1
-    customPlot1->addGraph();
+    // Add graph for Engine Load, using the default yAxis1. Time series draw straight from the
+    // dataset's columns instead of copying them into the graph
+    new QCPColumnGraph(customPlot1->xAxis, customPlot1->yAxis);
     customPlot1->graph(0)->setName("Engine Load"); // Name the first graph (for the legend later)
     customPlot1->graph(0)->setPen(QPen(QColor(0, 100, 0))); // Dark Green for Engine Load line
-    customPlot1->graph(0)->setData(plot1_x_time, plot1_y_engine_load);
+    bindGraph(customPlot1->graph(0), PlotDataset::Time, PlotDataset::EngineLoad);
 
     // Setup plot common properties with the new title and Y-axis label
     setupPlot(customPlot1, "Engine Load Over Time", "Time", "Engine Load (%)");
 
-    setupDateTimeAxis(customPlot1, plot1_x_time, customPlot1->xAxis);
-
-    customPlot1->rescaleAxes();
+    setupDateTimeAxis(customPlot1, time, customPlot1->xAxis);
 
-    markDayChanges(customPlot1, plot1_x_time);
+    markDayChanges(customPlot1);
 
     // Legend will show name of graph"
     customPlot1->legend->setVisible(true);
     customPlot1->legend->setBrush(QBrush(QColor(255, 255, 255, 150))); // Semi-transparent white background for legend
     customPlot1->legend->setTextColor(Qt::black); // Black text for legend on white background
 
-    customPlot1->replot();
-
     // --- Plot 2: SFOC vs. Engine Load ---
     customPlot2 = new QCustomPlot(this);
     mainLayout->addWidget(customPlot2, 0, 1, 1, 1);
     customPlot2->addGraph();
     setupPlot(customPlot2, "SFOC vs. Engine Load", "Engine Load (%)", "SFOC (gr/kWh)");
-    customPlot2->graph(0)->setData(plot2_x_engine_load, plot2_y_sfoc);
+    bindGraph(customPlot2->graph(0), PlotDataset::EngineLoad, PlotDataset::Sfoc);
     customPlot2->graph(0)->setPen(QPen(QColor(255, 69, 0))); // Orange Red
     customPlot2->graph(0)->setLineStyle(QCPGraph::lsNone);
     customPlot2->graph(0)->setScatterStyle(QCPScatterStyle(QCPScatterStyle::ssCircle, 5));
-    customPlot2->rescaleAxes();
-    customPlot2->yAxis->setRange(50, 300);
-    customPlot2->replot();
 
 
     // --- Plot 3: SOG & STW Over Time ---
     customPlot3 = new QCustomPlot(this);
     mainLayout->addWidget(customPlot3, 1, 1, 1, 1);
-    customPlot3->addGraph();
+    new QCPColumnGraph(customPlot3->xAxis, customPlot3->yAxis);
     customPlot3->graph(0)->setName("SOG (kn)");
     customPlot3->graph(0)->setPen(QPen(QColor(255, 10, 0))); // Dark Red
-    customPlot3->graph(0)->setData(plot3_x_time, plot3_y_sog);
-    customPlot3->addGraph();
+    bindGraph(customPlot3->graph(0), PlotDataset::Time, PlotDataset::Sog);
+    new QCPColumnGraph(customPlot3->xAxis, customPlot3->yAxis);
     customPlot3->graph(1)->setName("STW (kn)");
     customPlot3->graph(1)->setPen(QPen(QColor(139, 69, 19))); // Saddle Brown
-    customPlot3->graph(1)->setData(plot3_x_time, plot3_y_stw);
+    bindGraph(customPlot3->graph(1), PlotDataset::Time, PlotDataset::Stw);
     setupPlot(customPlot3, "Speed Performance Over Time", "Time", "Speed (kn)");
-    setupDateTimeAxis(customPlot3, plot3_x_time, customPlot3->xAxis);
-    customPlot3->rescaleAxes();
-    markDayChanges(customPlot3, plot3_x_time);
+    setupDateTimeAxis(customPlot3, time, customPlot3->xAxis);
+    markDayChanges(customPlot3);
     customPlot3->legend->setVisible(true);
     customPlot3->legend->setBrush(QBrush(QColor(255, 255, 255, 150)));
     customPlot3->legend->setTextColor(Qt::black);
-    customPlot3->replot();
+
+    // Engine load and speeds share the time domain: zooming or dragging either moves both
+    mTimeAxes = new AxisLink(this);
+    mTimeAxes->addAxis(customPlot1->xAxis);
+    mTimeAxes->addAxis(customPlot3->xAxis);
 
     // --- Plot 4: Hull & Propeller Performance ---
     customPlot4 = new QCustomPlot(this);
     mainLayout->addWidget(customPlot4, 2, 0, 1, 1);
     customPlot4->addGraph();
     setupPlot(customPlot4, "Hull & Propeller Performance", "Speed Over Ground (kn)", "Propeller Power (kW)");
-    customPlot4->graph(0)->setData(plot4_x_sog, plot4_y_prop_power);
+    bindGraph(customPlot4->graph(0), PlotDataset::Sog, PlotDataset::PropPower);
     customPlot4->graph(0)->setPen(QPen(QColor(65, 105, 225))); // Royal Blue
     customPlot4->graph(0)->setLineStyle(QCPGraph::lsNone);
     customPlot4->graph(0)->setScatterStyle(QCPScatterStyle(QCPScatterStyle::ssCircle, 5));
-    customPlot4->rescaleAxes();
-    customPlot4->replot();
 
     // --- Plot 5: Relative Wind Conditions ---
     customPlot5 = new QCustomPlot(this);
     mainLayout->addWidget(customPlot5, 2, 1, 1, 1);
     customPlot5->addGraph();
     setupPlot(customPlot5, "Relative Wind Conditions", "Relative Wind Direction (deg)", "Relative Wind Speed (m/s)");
-    customPlot5->graph(0)->setData(plot5_x_wind_dir, plot5_y_wind_speed);
+    bindGraph(customPlot5->graph(0), PlotDataset::RelWindDir, PlotDataset::RelWindSpeed);
     customPlot5->graph(0)->setPen(QPen(QColor(128, 0, 128))); // Purple
     customPlot5->graph(0)->setLineStyle(QCPGraph::lsNone);
     customPlot5->graph(0)->setScatterStyle(QCPScatterStyle(QCPScatterStyle::ssCross, 7));
-    customPlot5->rescaleAxes();
-    customPlot5->replot();
+
+    // --- Plot 6: Speed Loss Trend (ISO 19030 performance value) ---
+    customPlot6 = new QCustomPlot(this);
+    mainLayout->addWidget(customPlot6, 3, 0, 1, 2);
+    customPlot6->addGraph();
+    setupPlot(customPlot6, "Speed Loss vs. Baseline (Daily Mean)", "Date", "Speed Loss (%)");
+    customPlot6->graph(0)->setPen(QPen(QColor(0, 128, 128))); // Teal
+    customPlot6->graph(0)->setScatterStyle(QCPScatterStyle(QCPScatterStyle::ssDisc, 5));
+    setupDateTimeAxis(customPlot6, time, customPlot6->xAxis);
+    customPlot6->legend->setVisible(true);
+    customPlot6->legend->setBrush(QBrush(QColor(255, 255, 255, 150)));
+    customPlot6->legend->setTextColor(Qt::black);
+    updatePerformance();
+
+    // The plots are painted side by side on worker threads rather than one after the other
+    mReplot = new ParallelReplot(this);
+    for (QCustomPlot* plot : { customPlot1, customPlot2, customPlot3, customPlot4, customPlot5, customPlot6 }) {
+        mReplot->addPlot(plot);
+    }
 
     centralWidget->setLayout(mainLayout);
+
+    // Steady running only: drops manoeuvring, acceleration and load changes from every plot
+    QToolBar* toolBar = addToolBar("View");
+    QAction* steadyAction = toolBar->addAction("Steady state only");
+    steadyAction->setCheckable(true);
+    steadyAction->setToolTip("Show only rows where shaft speed, power and STW held steady");
+    connect(steadyAction, &QAction::toggled, this, &MainWindow::showSteadyOnly);
+
+    // Summary of whatever part of the log plot 1 shows, kept current while it is dragged or zoomed
+    mIntervalLabel = new QLabel(this);
+    statusBar()->addPermanentWidget(mIntervalLabel);
+    connect(customPlot1->xAxis, qOverload<const QCPRange&>(&QCPAxis::rangeChanged), this, &MainWindow::updateIntervalStats);
+
+    rescalePlots();
+    replotPlots(QCustomPlot::rpRefreshHint);
 }
 
 MainWindow::~MainWindow()
 {
 }
 
+// Shows two dataset channels in a graph and remembers the pairing for appended rows
+void MainWindow::bindGraph(QCPGraph* graph, PlotDataset::Channel key, PlotDataset::Channel value)
+{
+    if (!qobject_cast<QCPColumnGraph*>(graph)) {
+        new DensityScatter(graph); // Owned by the graph; turns it into a density map once it gets crowded
+    }
+    mBindings.append({ graph, key, value });
+    showBinding(mBindings.last());
+}
+
+// Hands the graph the shown dataset's channels
+void MainWindow::showBinding(const GraphBinding& binding)
+{
+    const PlotDataset& dataset = shownDataset();
+    if (QCPColumnGraph* columnGraph = qobject_cast<QCPColumnGraph*>(binding.graph)) {
+        columnGraph->setColumns(dataset.channel(binding.key).constData(), dataset.channel(binding.value).constData(), dataset.rowCount());
+    } else {
+        binding.graph->data()->set(scatterPoints(dataset.channel(binding.key), dataset.channel(binding.value)));
+    }
+}
+
+void MainWindow::setDataset(PlotDataset dataset)
+{
+    mDataset = std::move(dataset);
+    if (mSteadyOnly) {
+        mSteadyDataset = mDataset.steadyOnly();
+    }
+    for (const GraphBinding& binding : mBindings) {
+        showBinding(binding);
+    }
+    updateDaySpans();
+    updatePerformance();
+    rescalePlots();
+}
+
+bool MainWindow::savePlots(const QString& basePath, bool pdf, int width, int height)
+{
+    const QVector<QPair<QCustomPlot*, QString>> plots = {
+        { customPlot1, "engine_load" },
+        { customPlot2, "sfoc_vs_load" },
+        { customPlot3, "speed" },
+        { customPlot4, "hull_propeller" },
+        { customPlot5, "wind" },
+        { customPlot6, "speed_loss" }
+    };
+    if (!pdf) {
+        // Rendered and encoded concurrently, into images
+        QVector<QPair<QCustomPlot*, QString>> files;
+        for (const auto& plot : plots) {
+            files.append({ plot.first, basePath + "_" + plot.second + ".png" });
+        }
+        return mReplot->savePng(files, QSize(width, height));
+    }
+    bool saved = true;
+    for (const auto& plot : plots) {
+        saved = plot.first->savePdf(basePath + "_" + plot.second + ".pdf", width, height) && saved;
+    }
+    return saved;
+}
+
+void MainWindow::showSteadyOnly(bool steadyOnly)
+{
+    mSteadyOnly = steadyOnly;
+    mSteadyDataset = steadyOnly ? mDataset.steadyOnly() : PlotDataset();
+    for (const GraphBinding& binding : mBindings) {
+        showBinding(binding);
+    }
+    rescalePlots();
+    replotPlots(QCustomPlot::rpQueuedReplot);
+
+    if (steadyOnly) {
+        const QVector<double>& steady = mDataset.channel(PlotDataset::Steady);
+        const int steadyRows = static_cast<int>(std::count(steady.begin(), steady.end(), 1.0));
+        statusBar()->showMessage(QString("Steady running: %1 of %2 rows").arg(steadyRows).arg(steady.size()), 5000);
+    }
+}
+
+void MainWindow::appendData(const PlotDataset& rows)
+{
+    if (rows.rowCount() == 0) {
+        return;
+    }
+
+    const QVector<double>& time = rows.channel(PlotDataset::Time);
+    const QVector<double>& history = mDataset.channel(PlotDataset::Time);
+    const double previousLastKey = history.isEmpty() ? std::numeric_limits<double>::quiet_NaN() : history.last();
+    const int firstNewRow = mDataset.rowCount();
+    const bool appendedAtEnd = mDataset.append(rows);
+    const PlotDataset shownRows = mSteadyOnly ? rows.steadyOnly() : rows;
+    if (mSteadyOnly) {
+        mSteadyDataset.append(shownRows);
+    }
+    const PlotDataset& dataset = shownDataset();
+
+    // Time series view the dataset's columns, which may have moved while growing: point them at
+    // the new buffers. When the old rows stayed in place only the new ones are added to the
+    // graphs' sampling pyramids. Scatter plots hold their own copy with unordered keys; the
+    // container merges the new points in
+    for (const GraphBinding& binding : mBindings) {
+        if (QCPColumnGraph* columnGraph = qobject_cast<QCPColumnGraph*>(binding.graph)) {
+            const double* keys = dataset.channel(binding.key).constData();
+            const double* values = dataset.channel(binding.value).constData();
+            if (appendedAtEnd) {
+                columnGraph->appendColumns(keys, values, dataset.rowCount());
+            } else {
+                columnGraph->setColumns(keys, values, dataset.rowCount());
+            }
+        } else {
+            binding.graph->data()->add(scatterPoints(shownRows.channel(binding.key), shownRows.channel(binding.value)));
+        }
+    }
+    updateDaySpans();
+
+    // The baseline is fitted once the load is complete. After that only the new rows are
+    // evaluated, unless earlier rows moved or the log did not yet cover the whole reference period
+    // before them: the block crossing its end gets the last full refit
+    const double loggedSeconds = previousLastKey - firstValidTime(history);
+    if (!mLoadProgress && appendedAtEnd && mBaseline.valid() && loggedSeconds > ReferenceDays * SecondsPerDay) {
+        mDataset.computeSpeedLoss(mBaseline, firstNewRow);
+        const QVector<double>& speedLoss = mDataset.channel(PlotDataset::SpeedLoss);
+        mSpeedLossTrend.add(history.constData() + firstNewRow, speedLoss.constData() + firstNewRow, mDataset.rowCount() - firstNewRow);
+        showSpeedLossTrend();
+    } else if (!mLoadProgress) {
+        updatePerformance();
+    }
+
+    if (mLoadProgress) {
+        rescalePlots(); // Still loading: show everything read so far
+    } else {
+        followTimeRange(customPlot1, previousLastKey, time.last()); // Plot 3 follows through the axis link
+        updateIntervalStats();
+    }
+
+    replotPlots(QCustomPlot::rpQueuedReplot); // Several blocks arriving together cost one replot
+}
+
+void MainWindow::trackLoading(CsvLoader* loader)
+{
+    mLoadProgress = new QProgressBar(this);
+    mLoadProgress->setRange(0, 100);
+    mLoadProgress->setMaximumWidth(300);
+    QPushButton* cancelButton = new QPushButton("Cancel", this);
+    statusBar()->showMessage("Loading data...");
+    statusBar()->addPermanentWidget(mLoadProgress);
+    statusBar()->addPermanentWidget(cancelButton);
+
+    connect(cancelButton, &QPushButton::clicked, loader, &CsvLoader::cancel);
+    connect(loader, &CsvLoader::rowsLoaded, this, &MainWindow::appendData);
+    connect(loader, &CsvLoader::progress, mLoadProgress, [this](qint64 bytesDone, qint64 bytesTotal) {
+        mLoadProgress->setValue(bytesTotal > 0 ? static_cast<int>(bytesDone * 100 / bytesTotal) : 100);
+    });
+
+    // The plots keep whatever arrived before the load ended
+    auto endLoading = [this, cancelButton](const QString& message) {
+        delete mLoadProgress;
+        mLoadProgress = nullptr;
+        cancelButton->deleteLater(); // Its clicked() may be what got us here
+        statusBar()->showMessage(message, 10000);
+        updatePerformance();
+        rescalePlots();
+        replotPlots(QCustomPlot::rpQueuedReplot);
+    };
+    connect(loader, &CsvLoader::finished, this, [this, endLoading]() {
+        endLoading(QString("Loaded %1 rows").arg(mDataset.rowCount()));
+    });
+    connect(loader, &CsvLoader::cancelled, this, [endLoading]() {
+        endLoading("Loading cancelled");
+    });
+    connect(loader, &CsvLoader::failed, this, endLoading);
+}
+
+// Statistics of the rows in plot 1's time window. The dataset's time index finds the rows by
+// binary search and its block summaries give the means without a pass over the rows, so this
+// keeps up with every mouse move of a drag even on multi-million-row logs
+void MainWindow::updateIntervalStats()
+{
+    const PlotDataset& dataset = shownDataset();
+    const QCPRange range = customPlot1->xAxis->range();
+    const RowRange rows = dataset.rowsBetween(range.lower, range.upper);
+    if (rows.empty()) {
+        mIntervalLabel->setText("No rows in view");
+        return;
+    }
+
+    QString text = QString("In view: %1 rows").arg(rows.size());
+    const size_t gaps = dataset.gapCount(rows);
+    if (gaps > 0) {
+        text += QString(", %1 gaps (%2 h)").arg(gaps).arg(dataset.gapSeconds(rows) / 3600.0, 0, 'f', 1);
+    }
+    const IntervalStats load = dataset.stats(PlotDataset::EngineLoad, rows);
+    const IntervalStats sfoc = dataset.stats(PlotDataset::Sfoc, rows);
+    const IntervalStats stw = dataset.stats(PlotDataset::Stw, rows);
+    const IntervalStats steady = mDataset.stats(PlotDataset::Steady, rows); // Same rows in both datasets
+    text += QString(" | Load %1% (%2-%3)").arg(load.mean, 0, 'f', 1).arg(load.min, 0, 'f', 0).arg(load.max, 0, 'f', 0);
+    text += QString(" | SFOC %1 gr/kWh").arg(sfoc.mean, 0, 'f', 1);
+    text += QString(" | STW %1 kn").arg(stw.mean, 0, 'f', 1);
+    text += QString(" | Steady %1%").arg(100.0 * steady.mean, 0, 'f', 0);
+    mIntervalLabel->setText(text);
+}
+
+// Fits the speed-power baseline over the reference period, then evaluates every row against it
+// and rebuilds the daily trend: two linear passes over the dataset
+void MainWindow::updatePerformance()
+{
+    const QVector<double>& time = mDataset.channel(PlotDataset::Time);
+    mBaseline = fitReferenceBaseline(time.constData(), mDataset.channel(PlotDataset::Stw).constData(),
+        mDataset.channel(PlotDataset::PropPower).constData(), mDataset.channel(PlotDataset::Steady).constData(),
+        mDataset.rowCount(), ReferenceDays * SecondsPerDay);
+    mDataset.computeSpeedLoss(mBaseline);
+
+    mSpeedLossTrend.clear();
+    mSpeedLossTrend.add(time.constData(), mDataset.channel(PlotDataset::SpeedLoss).constData(), mDataset.rowCount());
+    showSpeedLossTrend();
+}
+
+void MainWindow::showSpeedLossTrend()
+{
+    const std::vector<double>& dayStarts = mSpeedLossTrend.dayStarts();
+    const std::vector<double> means = mSpeedLossTrend.means();
+    QVector<double> keys(static_cast<int>(dayStarts.size()));
+    for (int day = 0; day < keys.size(); ++day) {
+        keys[day] = dayStarts[day] + SecondsPerDay / 2; // Centred on its day
+    }
+    customPlot6->graph(0)->setData(keys, QVector<double>(means.begin(), means.end()), true);
+
+    if (mBaseline.valid()) {
+        customPlot6->graph(0)->setName(QString("Baseline P = %1 * STW^%2 (%3 steady samples)")
+            .arg(mBaseline.coefficient, 0, 'g', 4).arg(mBaseline.exponent, 0, 'f', 2).arg(mBaseline.sampleCount));
+    } else {
+        customPlot6->graph(0)->setName("No baseline: too few steady samples in the reference period");
+    }
+}
+
+// Fits every plot to its data
+void MainWindow::rescalePlots()
+{
+    customPlot1->rescaleAxes();
+    customPlot2->rescaleAxes();
+    if (!mSteadyOnly) {
+        customPlot2->yAxis->setRange(50, 300); // Transients spread SFOC far beyond the useful range
+    }
+    customPlot3->rescaleAxes();
+    customPlot4->rescaleAxes();
+    customPlot5->rescaleAxes();
+    customPlot6->rescaleAxes();
+    updateIntervalStats(); // Also when plot 1's range came out the same but its rows changed
+}
+
+void MainWindow::replotPlots(QCustomPlot::RefreshPriority priority)
+{
+    if (priority == QCustomPlot::rpQueuedReplot) {
+        mReplot->queueReplot();
+    } else {
+        mReplot->replot();
+    }
+}
+
+// Keeps the newest data in view while the user is looking at the live end of a time plot
+void MainWindow::followTimeRange(QCustomPlot* plot, double previousLastKey, double newLastKey)
+{
+    QCPRange range = plot->xAxis->range();
+    if (std::isnan(previousLastKey) || range.upper < previousLastKey || newLastKey <= range.upper) {
+        return; // Zoomed or dragged into the history, or the new rows are already visible
+    }
+    plot->xAxis->setRange(newLastKey - range.size(), newLastKey);
+}
+
 void MainWindow::setupPlot(QCustomPlot* plot, const QString& title, const QString& xAxisLabel, const QString& yAxisLabel)
 {
 
@@ -176,40 +486,27 @@ void MainWindow::setupDateTimeAxis(QCustomPlot* plot, const QVector<double>& xDa
 {
     QSharedPointer<QCPAxisTickerDateTime> dateTimeTicker(new QCPAxisTickerDateTime);
     dateTimeTicker->setDateTimeFormat("dd/MM/yyyy\nHH:mm");
+    dateTimeTicker->setDateTimeSpec(Qt::UTC); // Timestamps are parsed as logger (UTC) time
     axis->setTicker(dateTimeTicker);
     axis->setTickLabelRotation(0);
     axis->setTickLabelFont(QFont(font().family(), 8));
 }
 
-void MainWindow::markDayChanges(QCustomPlot* plot, const QVector<double>& xData)
+// Marks every midnight on the plot's time axis, for the whole dataset as it grows
+void MainWindow::markDayChanges(QCustomPlot* plot)
+{
+    mDayBoundaries.append(new DayBoundaries(plot->xAxis));
+    updateDaySpans();
+}
+
+// Rows are kept in time order, so the first and last one span the data
+void MainWindow::updateDaySpans()
 {
-    if (xData.isEmpty()) {
+    const QVector<double>& time = mDataset.channel(PlotDataset::Time);
+    if (time.isEmpty()) {
         return;
     }
-
-    QDateTime currentDay = QDateTime::fromSecsSinceEpoch(static_cast<qint64>(xData.first())).date().startOfDay();
-
-    for (int i = 0; i < xData.size(); ++i)
-    {
-        QDateTime pointDateTime = QDateTime::fromSecsSinceEpoch(static_cast<qint64>(xData[i]));
-
-        if (pointDateTime.date() > currentDay.date())
-        {
-            QDateTime midnightOfNewDay = pointDateTime.date().startOfDay();
-            QCPItemLine* dayLine = new QCPItemLine(plot);
-            dayLine->setPen(QPen(Qt::red, 1, Qt::DashLine));
-            dayLine->start->setAxes(plot->xAxis, plot->yAxis);
-            dayLine->end->setAxes(plot->xAxis, plot->yAxis);
-            dayLine->start->setCoords(midnightOfNewDay.toSecsSinceEpoch(), plot->yAxis->range().lower);
-            dayLine->end->setCoords(midnightOfNewDay.toSecsSinceEpoch(), plot->yAxis->range().upper);
-            QCPItemText* dayLabel = new QCPItemText(plot);
-            dayLabel->position->setParentAnchor(dayLine->start);
-            dayLabel->position->setCoords(5, 15);
-            dayLabel->setText(midnightOfNewDay.date().toString("MMM dd"));
-            dayLabel->setFont(QFont(font().family(), 9, QFont::Bold));
-            dayLabel->setColor(Qt::red);
-            dayLabel->setTextAlignment(Qt::AlignLeft | Qt::AlignVCenter);
-            currentDay = midnightOfNewDay;
-        }
+    for (DayBoundaries* boundaries : mDayBoundaries) {
+        boundaries->setDataSpan(time.first(), time.last());
     }
 }
\ No newline at end of file
@@ -5,40 +5,88 @@
 
 #include <QMainWindow>
 #include "qcustomplot.h"
+#include "plotDataset.h"
+#include "dayBoundaries.h"
+#include "csvLoader.h"
+#include "axisLink.h"
+#include "parallelReplot.h"
 #include <QVector>
 #include <QString>
 #include <QDateTime>
+#include <QProgressBar>
+#include <QLabel>
 
 class MainWindow : public QMainWindow
 {
     Q_OBJECT
 
 public:
-    MainWindow(QWidget* parent = nullptr,
-        const QVector<double>& plot1_x_time = {},
-        const QVector<double>& plot1_y_engine_load = {},
-        const QVector<double>& plot2_x_engine_load = {},
-        const QVector<double>& plot2_y_sfoc = {},
-        const QVector<double>& plot3_x_time = {},
-        const QVector<double>& plot3_y_sog = {},
-        const QVector<double>& plot3_y_stw = {},
-        const QVector<double>& plot4_x_sog = {},
-        const QVector<double>& plot4_y_prop_power = {},
-        const QVector<double>& plot5_x_wind_dir = {},
-        const QVector<double>& plot5_y_wind_speed = {});
+    // Takes the dataset over (pass it with std::move so follow mode can grow it in place)
+    MainWindow(QWidget* parent = nullptr, PlotDataset dataset = PlotDataset());
 
     ~MainWindow();
 
+    // Appends rows read after the window was created (background loading, follow mode). The time
+    // series get the new points in order; the scatter plots merge them in.
+    void appendData(const PlotDataset& rows);
+
+    // Adds the loader's rows as they arrive, with a progress bar and a cancel button in the
+    // status bar until loading ends.
+    void trackLoading(CsvLoader* loader);
+
+    // Replaces the dataset shown by every plot and fits the axes to it (batch reports reuse one
+    // window for many files).
+    void setDataset(PlotDataset dataset);
+
+    // Renders every plot to <basePath>_<plot>.png (or .pdf) at the given size, without
+    // needing the window on screen. Returns false if any file could not be written.
+    bool savePlots(const QString& basePath, bool pdf, int width, int height);
+
+    // Limits every plot to the rows logged at steady running (PlotDataset::Steady), or shows all.
+    void showSteadyOnly(bool steadyOnly);
+
 private:
     QCustomPlot* customPlot1;
     QCustomPlot* customPlot2;
     QCustomPlot* customPlot3;
     QCustomPlot* customPlot4;
     QCustomPlot* customPlot5;
+    QCustomPlot* customPlot6;
+
+    // Which dataset channels a graph shows
+    struct GraphBinding
+    {
+        QCPGraph* graph;
+        PlotDataset::Channel key;
+        PlotDataset::Channel value;
+    };
+
+    PlotDataset mDataset;
+    PlotDataset mSteadyDataset; // mDataset.steadyOnly(), while the plots are limited to steady rows
+    bool mSteadyOnly = false;
+    SpeedPowerBaseline mBaseline;  // Fitted over the reference period at the start of the log
+    DailyTrend mSpeedLossTrend;
+    QVector<GraphBinding> mBindings;
+    QVector<DayBoundaries*> mDayBoundaries; // Owned by their plots
+    AxisLink* mTimeAxes;                    // Time axes of the engine load and speed plots
+    ParallelReplot* mReplot;                // All six plots, painted concurrently
+    QProgressBar* mLoadProgress = nullptr;  // Only while a load is running
+    QLabel* mIntervalLabel;                 // Statistics of the time window shown by plot 1
+
+    void bindGraph(QCPGraph* graph, PlotDataset::Channel key, PlotDataset::Channel value);
+    void showBinding(const GraphBinding& binding);
+    const PlotDataset& shownDataset() const { return mSteadyOnly ? mSteadyDataset : mDataset; }
 
     void setupPlot(QCustomPlot* plot, const QString& title, const QString& xAxisLabel, const QString& yAxisLabel);
     void setupDateTimeAxis(QCustomPlot* plot, const QVector<double>& xData, QCPAxis* axis);
-    void markDayChanges(QCustomPlot* plot, const QVector<double>& xData);
+    void markDayChanges(QCustomPlot* plot);
+    void updateDaySpans();
+    void followTimeRange(QCustomPlot* plot, double previousLastKey, double newLastKey);
+    void updateIntervalStats();
+    void updatePerformance();
+    void showSpeedLossTrend();
+    void rescalePlots();
+    void replotPlots(QCustomPlot::RefreshPriority priority);
 
 };
 
@@ -0,0 +1,137 @@
+// mappedFile.cpp
+
+#include "mappedFile.h"
+#include <utility>   // Required for std::exchange
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::string& filename)
+{
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        CloseHandle(file);
+        return;
+    }
+
+    mFileHandle = file;
+    mOpen = true;
+    if (fileSize.QuadPart == 0) {
+        return; // Empty files cannot be mapped, but they are still valid (and empty)
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        close();
+        return;
+    }
+    mMappingHandle = mapping;
+
+    const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) {
+        close();
+        return;
+    }
+    mData = static_cast<const char*>(view);
+    mSize = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+
+    struct stat fileInfo;
+    if (::fstat(fd, &fileInfo) != 0) {
+        ::close(fd);
+        return;
+    }
+
+    mOpen = true;
+    if (fileInfo.st_size > 0) {
+        void* view = ::mmap(nullptr, static_cast<size_t>(fileInfo.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (view == MAP_FAILED) {
+            mOpen = false;
+        }
+        else {
+            ::madvise(view, static_cast<size_t>(fileInfo.st_size), MADV_SEQUENTIAL); // The parsers stream front to back
+            mData = static_cast<const char*>(view);
+            mSize = static_cast<size_t>(fileInfo.st_size);
+        }
+    }
+    ::close(fd); // The mapping keeps its own reference to the file
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : mData(std::exchange(other.mData, nullptr)),
+      mSize(std::exchange(other.mSize, 0)),
+      mOpen(std::exchange(other.mOpen, false))
+#ifdef _WIN32
+    , mFileHandle(std::exchange(other.mFileHandle, nullptr)),
+      mMappingHandle(std::exchange(other.mMappingHandle, nullptr))
+#endif
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other) {
+        close();
+        mData = std::exchange(other.mData, nullptr);
+        mSize = std::exchange(other.mSize, 0);
+        mOpen = std::exchange(other.mOpen, false);
+#ifdef _WIN32
+        mFileHandle = std::exchange(other.mFileHandle, nullptr);
+        mMappingHandle = std::exchange(other.mMappingHandle, nullptr);
+#endif
+    }
+    return *this;
+}
+
+void MappedFile::close()
+{
+#ifdef _WIN32
+    if (mData != nullptr) {
+        UnmapViewOfFile(mData);
+    }
+    if (mMappingHandle != nullptr) {
+        CloseHandle(static_cast<HANDLE>(mMappingHandle));
+    }
+    if (mFileHandle != nullptr) {
+        CloseHandle(static_cast<HANDLE>(mFileHandle));
+    }
+    mFileHandle = nullptr;
+    mMappingHandle = nullptr;
+#else
+    if (mData != nullptr) {
+        ::munmap(const_cast<char*>(mData), mSize);
+    }
+#endif
+    mData = nullptr;
+    mSize = 0;
+    mOpen = false;
+}
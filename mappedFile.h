@@ -0,0 +1,41 @@
+// mappedFile.h
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <string>
+#include <string_view>
+#include <cstddef>
+
+// Read-only memory mapping of a whole file.
+// Views handed out by view() point into the mapping and stay valid only as long as the
+// MappedFile they came from.
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::string& filename);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    bool isOpen() const { return mOpen; }
+    const char* data() const { return mData; }
+    size_t size() const { return mSize; }
+    std::string_view view() const { return std::string_view(mData, mSize); }
+
+private:
+    void close();
+
+    const char* mData = nullptr;
+    size_t mSize = 0;
+    bool mOpen = false;
+#ifdef _WIN32
+    void* mFileHandle = nullptr;    // HANDLE of the opened file
+    void* mMappingHandle = nullptr; // HANDLE of the file mapping object
+#endif
+};
+
+#endif // MAPPED_FILE_H
@@ -0,0 +1,153 @@
+// parallelReplot.cpp
+#include "parallelReplot.h"
+#include "threadPool.h"
+#include <QEvent>    // Required for QEvent::Resize
+#include <QTimer>    // Required for QTimer::singleShot
+#include <QImage>    // Required for saving the rendered plots
+#include <atomic>    // Required for std::atomic
+#include <future>    // Required for std::future
+#include <vector>    // Required for std::vector
+
+namespace {
+
+// Painting gets its own workers: on the shared pool a replot would queue behind the chunks of a
+// file being parsed in the background, with the GUI thread waiting for it
+ThreadPool& paintPool()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+} // namespace
+
+ParallelReplot::ParallelReplot(QObject* parent)
+    : QObject(parent)
+{
+}
+
+void ParallelReplot::addPlot(QCustomPlot* plot)
+{
+    plot->setThreadedPainting(true);
+    plot->installEventFilter(this);
+    mPlots.append(plot);
+}
+
+void ParallelReplot::replot()
+{
+    mQueued = false;
+    QVector<QCustomPlot*> plots;
+    for (const QPointer<QCustomPlot>& plot : mPlots) {
+        if (plot) {
+            plots.append(plot);
+        }
+    }
+    replotConcurrently(plots, nullptr);
+}
+
+void ParallelReplot::queueReplot()
+{
+    if (mQueued) {
+        return;
+    }
+    mQueued = true;
+    QTimer::singleShot(0, this, &ParallelReplot::replot);
+}
+
+bool ParallelReplot::savePng(const QVector<QPair<QCustomPlot*, QString>>& files, const QSize& size)
+{
+    // Only the group's plots paint into images, so any other plot is a file that cannot be written
+    bool saved = true;
+    QVector<QCustomPlot*> plots;
+    QVector<QString> fileNames;
+    for (const QPair<QCustomPlot*, QString>& file : files) {
+        if (file.first && mPlots.contains(file.first)) {
+            plots.append(file.first);
+            fileNames.append(file.second);
+        } else {
+            saved = false;
+        }
+    }
+
+    // The plots are laid out and painted at the export size, then get the widgets' back
+    QVector<QRect> viewports(plots.size());
+    QVector<double> pixelRatios(plots.size());
+    bool onScreen = false;
+    for (int i = 0; i < plots.size(); ++i) {
+        viewports[i] = plots[i]->viewport();
+        pixelRatios[i] = plots[i]->bufferDevicePixelRatio();
+        onScreen = onScreen || plots[i]->isVisible();
+        plots[i]->setBufferDevicePixelRatio(1.0);
+        plots[i]->setViewport(QRect(QPoint(0, 0), size));
+    }
+
+    // One flag per file, each set by the thread that wrote it; a plot that was not painted (a
+    // second request for the same plot, or one with nothing to lay out) leaves its flag unset
+    std::vector<char> written(plots.size(), 0);
+    replotConcurrently(plots, [&plots, &fileNames, &written](int index) {
+        QImage image = plots[index]->bufferImage();
+        const int dotsPerMeter = int(96 / 0.0254); // 96 dpi, as QCustomPlot::savePng
+        image.setDotsPerMeterX(dotsPerMeter);
+        image.setDotsPerMeterY(dotsPerMeter);
+        written[index] = image.save(fileNames[index], "PNG");
+    });
+
+    for (int i = 0; i < plots.size(); ++i) {
+        plots[i]->setViewport(viewports[i]);
+        plots[i]->setBufferDevicePixelRatio(pixelRatios[i]);
+        saved = saved && written[i];
+    }
+    // The export pass left its images in the buffers, with an update of each widget already posted.
+    // On screen the buffers are redrawn at the widgets' own size right away, so that update shows
+    // the plots as they were; headless there is nothing to show
+    if (onScreen) {
+        replot();
+    }
+    return saved;
+}
+
+void ParallelReplot::replotConcurrently(const QVector<QCustomPlot*>& plots, const std::function<void(int)>& afterPaint)
+{
+    QVector<int> prepared;
+    for (int i = 0; i < plots.size(); ++i) {
+        if (plots[i]->prepareReplot()) {
+            prepared.append(i);
+        }
+    }
+    if (prepared.isEmpty()) {
+        return;
+    }
+
+    // Each plot paints only its own layerables into its own buffers. This thread paints the first
+    // plot itself and then waits, so nothing touches the plots while the workers are painting
+    auto paint = [&plots, &afterPaint](int index) {
+        plots[index]->paintLayers();
+        if (afterPaint) {
+            afterPaint(index);
+        }
+    };
+    std::vector<std::future<void>> painted;
+    for (int i = 1; i < prepared.size(); ++i) {
+        const int index = prepared[i];
+        painted.push_back(paintPool().submit([&paint, index]() { paint(index); }));
+    }
+    paint(prepared.first());
+    for (std::future<void>& done : painted) {
+        done.get();
+    }
+
+    for (int index : prepared) {
+        plots[index]->finishReplot(QCustomPlot::rpRefreshHint);
+    }
+}
+
+bool ParallelReplot::eventFilter(QObject* watched, QEvent* event)
+{
+    if (event->type() == QEvent::Resize) {
+        // Takes over QCustomPlot::resizeEvent, which would replot this plot alone right away
+        QCustomPlot* plot = static_cast<QCustomPlot*>(watched);
+        plot->setViewport(plot->rect());
+        queueReplot();
+        return true;
+    }
+    return QObject::eventFilter(watched, event);
+}
\ No newline at end of file
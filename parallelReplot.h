@@ -0,0 +1,55 @@
+// parallelReplot.h
+#ifndef PARALLEL_REPLOT_H
+#define PARALLEL_REPLOT_H
+
+#include <QObject>
+#include <QPointer>
+#include <QVector>
+#include <QPair>
+#include <QString>
+#include <QSize>
+#include <functional>
+#include "qcustomplot.h"
+
+// Replots a group of plots together, painting their layers concurrently: the GUI thread lays out
+// every plot, worker threads paint one plot each into its QImage paint buffers, and the GUI thread
+// composites the buffers when the widgets repaint. A full repaint of the group then takes about as
+// long as its slowest plot rather than the sum of all of them.
+//
+// Resizing a plot of the group no longer replots it on the spot; the group is replotted once all
+// the resize events of a layout pass have arrived.
+class ParallelReplot : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ParallelReplot(QObject* parent = nullptr);
+
+    // Switches the plot to image paint buffers and watches it for resizes.
+    void addPlot(QCustomPlot* plot);
+
+    // Replots every plot of the group now.
+    void replot();
+
+    // Replots the group once on the next pass of the event loop, however often this is called.
+    void queueReplot();
+
+    // Renders each plot at the given size (device pixel ratio 1) and saves it as PNG to the file name
+    // paired with it. Painting, compositing and encoding all run on the workers, on QImages only, so
+    // this works headless and without a GPU. Returns false if any file was not written, including
+    // those of plots outside the group or plots that could not be painted.
+    bool savePng(const QVector<QPair<QCustomPlot*, QString>>& files, const QSize& size);
+
+protected:
+    bool eventFilter(QObject* watched, QEvent* event) override;
+
+private:
+    QVector<QPointer<QCustomPlot>> mPlots;
+    bool mQueued = false;
+
+    // Replots the given plots of the group with their layers painted concurrently; afterPaint, if
+    // given, runs on the painting thread right after each plot is painted (with its index in plots)
+    void replotConcurrently(const QVector<QCustomPlot*>& plots, const std::function<void(int)>& afterPaint);
+};
+
+#endif // PARALLEL_REPLOT_H
\ No newline at end of file
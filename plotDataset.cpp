@@ -0,0 +1,128 @@
+// plotDataset.cpp
+#include "plotDataset.h"
+#include "derivedMetrics.h"
+#include <algorithm>  // Required for std::copy, std::is_sorted, std::stable_sort
+#include <limits>     // Required for std::numeric_limits<double>::quiet_NaN()
+#include <numeric>    // Required for std::iota
+#include <vector>     // Required for std::vector
+
+constexpr double PlotDataset::MaxGapSeconds;
+
+PlotDataset PlotDataset::fromLogger(const LoggerChannels& in, size_t rowCount, double mcr, SteadyStateDetector& steady)
+{
+    PlotDataset dataset;
+    const int rows = static_cast<int>(rowCount);
+    for (QVector<double>& channel : dataset.mChannels) {
+        channel.resize(rows);
+    }
+
+    double* time = dataset.mChannels[Time].data();
+    for (int i = 0; i < rows; ++i) {
+        time[i] = static_cast<double>(in.time[i]);
+    }
+    std::copy(in.sog, in.sog + rowCount, dataset.mChannels[Sog].data());
+    std::copy(in.stw, in.stw + rowCount, dataset.mChannels[Stw].data());
+    std::copy(in.propPower, in.propPower + rowCount, dataset.mChannels[PropPower].data());
+    std::copy(in.relWindDir, in.relWindDir + rowCount, dataset.mChannels[RelWindDir].data());
+    std::copy(in.relWindSpeed, in.relWindSpeed + rowCount, dataset.mChannels[RelWindSpeed].data());
+    if (in.propRev) {
+        std::copy(in.propRev, in.propRev + rowCount, dataset.mChannels[PropRev].data());
+    }
+    else {
+        dataset.mChannels[PropRev].fill(std::numeric_limits<double>::quiet_NaN());
+    }
+
+    // Derived channels are written straight into their buffers
+    computeDerivedMetrics({ in.propPower, in.foc, in.sog }, rowCount, mcr,
+        { dataset.mChannels[EngineLoad].data(), dataset.mChannels[Sfoc].data() });
+
+    // In log order, before any re-sort, as the detector's windows run along the file
+    steady.flag(in.propRev, in.propPower, in.stw, rowCount, dataset.mChannels[Steady].data());
+    dataset.mChannels[SpeedLoss].fill(std::numeric_limits<double>::quiet_NaN()); // Needs the whole reference period
+
+    if (!std::is_sorted(time, time + rows)) {
+        dataset.sortByTime();
+    }
+    dataset.reindex();
+    return dataset;
+}
+
+bool PlotDataset::append(const PlotDataset& rows)
+{
+    const QVector<double>& time = mChannels[Time];
+    const QVector<double>& newTime = rows.mChannels[Time];
+    // Appended rows are sorted already; only a step back across the seam needs a re-sort
+    const bool stillSorted = time.isEmpty() || newTime.isEmpty() || time.last() <= newTime.first();
+    const int firstNewRow = rowCount();
+
+    for (int channel = 0; channel < ChannelCount; ++channel) {
+        mChannels[channel].append(rows.mChannels[channel]);
+    }
+    if (!stillSorted) {
+        sortByTime();
+    }
+    reindex(stillSorted ? firstNewRow : 0);
+    return stillSorted;
+}
+
+PlotDataset PlotDataset::steadyOnly() const
+{
+    PlotDataset steadyRows = *this; // Shares the buffers until they are written to
+    const QVector<double>& steady = mChannels[Steady];
+    for (int channel = 0; channel < ChannelCount; ++channel) {
+        if (channel == Time || channel == Steady) {
+            continue;
+        }
+        double* values = steadyRows.mChannels[channel].data();
+        for (int i = 0; i < steady.size(); ++i) {
+            if (steady[i] == 0.0) {
+                values[i] = std::numeric_limits<double>::quiet_NaN();
+            }
+        }
+    }
+    steadyRows.reindex();
+    return steadyRows;
+}
+
+void PlotDataset::computeSpeedLoss(const SpeedPowerBaseline& baseline, int firstRow)
+{
+    const size_t count = static_cast<size_t>(rowCount() - firstRow);
+    ::computeSpeedLoss(baseline, mChannels[Stw].constData() + firstRow, mChannels[PropPower].constData() + firstRow,
+        mChannels[Steady].constData() + firstRow, count, mChannels[SpeedLoss].data() + firstRow);
+    mSummaries[SpeedLoss].update(mChannels[SpeedLoss].constData(), static_cast<size_t>(rowCount()), static_cast<size_t>(firstRow));
+}
+
+RowRange PlotDataset::rowsBetween(double fromTime, double toTime) const
+{
+    return TimeIndex::rowsBetween(mChannels[Time].constData(), static_cast<size_t>(rowCount()), fromTime, toTime);
+}
+
+IntervalStats PlotDataset::stats(Channel channel, RowRange rows) const
+{
+    return mSummaries[channel].stats(mChannels[channel].constData(), rows);
+}
+
+void PlotDataset::reindex(int firstRow)
+{
+    const size_t count = static_cast<size_t>(rowCount());
+    mTimeIndex.update(mChannels[Time].constData(), count, static_cast<size_t>(firstRow));
+    for (int channel = 0; channel < ChannelCount; ++channel) {
+        mSummaries[channel].update(mChannels[channel].constData(), count, static_cast<size_t>(firstRow));
+    }
+}
+
+void PlotDataset::sortByTime()
+{
+    const QVector<double>& time = mChannels[Time];
+    std::vector<int> order(static_cast<size_t>(time.size()));
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&time](int a, int b) { return time[a] < time[b]; });
+
+    for (QVector<double>& channel : mChannels) {
+        QVector<double> sorted(channel.size());
+        for (int i = 0; i < sorted.size(); ++i) {
+            sorted[i] = channel[order[i]];
+        }
+        channel = std::move(sorted);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,96 @@
+// plotDataset.h
+#ifndef PLOT_DATASET_H
+#define PLOT_DATASET_H
+
+#include <QVector>
+#include <cstdint>
+#include <cstddef>
+#include "steadyState.h"
+#include "speedPowerBaseline.h"
+#include "timeIndex.h"
+
+// Raw logger channels a PlotDataset is built from, rowCount values each.
+struct LoggerChannels
+{
+    const std::int64_t* time = nullptr; // Seconds since epoch (UTC)
+    const double* sog = nullptr;
+    const double* stw = nullptr;
+    const double* propPower = nullptr;
+    const double* propRev = nullptr;    // May stay null: not every logger records shaft speed
+    const double* foc = nullptr;
+    const double* relWindDir = nullptr;
+    const double* relWindSpeed = nullptr;
+};
+
+// Column-major data shared by all plots: one buffer per channel, allocated once. Plots refer to
+// channels rather than holding their own copies, so a channel shown in several plots (engine
+// load, SOG) exists only once. Rows are kept in ascending time order and indexed by time, so the
+// rows and summary statistics of any time window are found without scanning the dataset.
+class PlotDataset
+{
+public:
+    enum Channel
+    {
+        Time,
+        EngineLoad,
+        Sfoc,
+        Sog,
+        Stw,
+        PropPower,
+        RelWindDir,
+        RelWindSpeed,
+        PropRev,
+        Steady, // 1 for rows logged at steady running, 0 for transients (see SteadyStateDetector)
+        SpeedLoss, // % against the speed-power baseline; NaN until computeSpeedLoss has run
+        ChannelCount
+    };
+
+    PlotDataset() = default;
+
+    // Copies the measured channels and derives engine load and SFOC (for the given MCR, kW). The
+    // rows are flagged by the detector, which carries its windows over from the rows it saw
+    // before, so a log converted block by block is flagged as if in one piece.
+    static PlotDataset fromLogger(const LoggerChannels& in, size_t rowCount, double mcr, SteadyStateDetector& steady);
+
+    int rowCount() const { return static_cast<int>(mChannels[Time].size()); }
+    const QVector<double>& channel(Channel channel) const { return mChannels[channel]; }
+
+    // Appends the rows of another dataset (follow mode). Returns false if they had to be sorted in
+    // among the existing rows, i.e. earlier rows moved.
+    bool append(const PlotDataset& rows);
+
+    // The same rows with every measured and derived value of the transient ones set to NaN, so
+    // time series show gaps there and scatter plots leave them out.
+    PlotDataset steadyOnly() const;
+
+    // Rows logged within [fromTime, toTime], by binary search over the time channel.
+    RowRange rowsBetween(double fromTime, double toTime) const;
+
+    // Count, mean, minimum and maximum of a channel over the rows (NaN left out), from the
+    // channel's block summaries: O(log n) for the mean plus one step per 1024 rows for the extremes.
+    IntervalStats stats(Channel channel, RowRange rows) const;
+
+    // Logger outages within the rows: intervals longer than MaxGapSeconds without a row.
+    size_t gapCount(RowRange rows) const { return mTimeIndex.gapCount(rows); }
+    double gapSeconds(RowRange rows) const { return mTimeIndex.gapSeconds(rows); }
+
+    static constexpr double MaxGapSeconds = 600.0;
+
+    // Fills the SpeedLoss channel of the rows from firstRow on (steady rows within the baseline's
+    // speed range; NaN for the others).
+    void computeSpeedLoss(const SpeedPowerBaseline& baseline, int firstRow = 0);
+
+private:
+    QVector<double> mChannels[ChannelCount];
+    TimeIndex mTimeIndex = TimeIndex(MaxGapSeconds);
+    BlockSummary mSummaries[ChannelCount];
+
+    // Brings the time index and the channel summaries up to date for the rows from firstRow on
+    void reindex(int firstRow = 0);
+
+    // Time series graphs read the channels in place and need ascending time; a logger that
+    // stepped its clock back gets its rows reordered (stable, so equal timestamps keep their order)
+    void sortByTime();
+};
+
+#endif // PLOT_DATASET_H
\ No newline at end of file
@@ -719,6 +719,85 @@ void QCPPaintBufferPixmap::reallocateBuffer()
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////// QCPPaintBufferImage
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*! \class QCPPaintBufferImage
+  \brief A paint buffer based on QImage, using software raster rendering
+
+  Unlike QPixmap, a QImage may be painted on from any thread, and needs no windowing system or
+  GPU. This paint buffer is used if \ref QCustomPlot::setThreadedPainting is true, so that \ref
+  QCustomPlot::paintLayers can run on a worker thread while the GUI thread only composites the
+  finished buffers in the paint event. Layers in \ref QCPLayer::lmBuffered mode get a buffer of
+  their own as with the other paint buffers, so \ref QCPLayer::replot still repaints just that
+  layer. Headless applications can read the result of a replot with \ref
+  QCustomPlot::bufferImage, off the GUI thread as well.
+
+  Painters returned by \ref startPainting have \ref QCPPainter::pmNoCaching set, because the
+  axis label cache keeps its labels in pixmaps.
+*/
+
+/*!
+  Creates an image paint buffer instance with the specified \a size and \a devicePixelRatio, if
+  applicable.
+*/
+QCPPaintBufferImage::QCPPaintBufferImage(const QSize &size, double devicePixelRatio) :
+    QCPAbstractPaintBuffer(size, devicePixelRatio)
+{
+    QCPPaintBufferImage::reallocateBuffer();
+}
+
+QCPPaintBufferImage::~QCPPaintBufferImage()
+{
+}
+
+/* inherits documentation from base class */
+QCPPainter *QCPPaintBufferImage::startPainting()
+{
+    QCPPainter *result = new QCPPainter(&mBuffer);
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+    result->setRenderHint(QPainter::HighQualityAntialiasing);
+#endif
+    result->setMode(QCPPainter::pmNoCaching);
+    return result;
+}
+
+/* inherits documentation from base class */
+void QCPPaintBufferImage::draw(QCPPainter *painter) const
+{
+    if (painter && painter->isActive())
+        painter->drawImage(0, 0, mBuffer);
+    else
+        qDebug() << Q_FUNC_INFO << "invalid or inactive painter passed";
+}
+
+/* inherits documentation from base class */
+void QCPPaintBufferImage::clear(const QColor &color)
+{
+    mBuffer.fill(color);
+}
+
+/* inherits documentation from base class */
+void QCPPaintBufferImage::reallocateBuffer()
+{
+    setInvalidated();
+    if (!qFuzzyCompare(1.0, mDevicePixelRatio))
+    {
+#ifdef QCP_DEVICEPIXELRATIO_SUPPORTED
+        mBuffer = QImage(mSize*mDevicePixelRatio, QImage::Format_ARGB32_Premultiplied);
+        mBuffer.setDevicePixelRatio(mDevicePixelRatio);
+#else
+        qDebug() << Q_FUNC_INFO << "Device pixel ratios not supported for Qt versions before 5.4";
+        mDevicePixelRatio = 1.0;
+        mBuffer = QImage(mSize, QImage::Format_ARGB32_Premultiplied);
+#endif
+    } else
+    {
+        mBuffer = QImage(mSize, QImage::Format_ARGB32_Premultiplied);
+    }
+}
+
 
 #ifdef QCP_OPENGL_PBUFFER
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -13618,6 +13697,7 @@ QCustomPlot::QCustomPlot(QWidget *parent) :
     mSelectionRectMode(QCP::srmNone),
     mSelectionRect(nullptr),
     mOpenGl(false),
+    mThreadedPainting(false),
     mMouseHasMoved(false),
     mMouseEventLayerable(nullptr),
     mMouseSignalLayerable(nullptr),
@@ -14101,6 +14181,23 @@ void QCustomPlot::setOpenGl(bool enabled, int multisampling)
 #endif
 }
 
+/*!
+  If \a enabled is true, the paint buffers are QImages (\ref QCPPaintBufferImage) instead of
+  QPixmaps, which allows \ref paintLayers to run on a worker thread. Has no effect while OpenGL is
+  enabled (\ref setOpenGl).
+
+  \see prepareReplot, paintLayers, finishReplot
+*/
+void QCustomPlot::setThreadedPainting(bool enabled)
+{
+    if (mThreadedPainting == enabled)
+        return;
+    mThreadedPainting = enabled;
+    // recreate all paint buffers:
+    mPaintBuffers.clear();
+    setupPaintBuffers();
+}
+
 /*!
   Sets the viewport of this QCustomPlot. Usually users of QCustomPlot don't need to change the
   viewport manually.
@@ -15113,6 +15210,10 @@ void QCustomPlot::deselectAll()
   replot only that specific layer via \ref QCPLayer::replot. See the documentation there for
   details.
 
+  A replot consists of the three phases \ref prepareReplot, \ref paintLayers and \ref
+  finishReplot, which may also be called individually, e.g. to paint the layers of several plots
+  concurrently.
+
   \see replotTime
 */
 void QCustomPlot::replot(QCustomPlot::RefreshPriority refreshPriority)
@@ -15127,37 +15228,71 @@ void QCustomPlot::replot(QCustomPlot::RefreshPriority refreshPriority)
         return;
     }
 
-    if (mReplotting) // incase signals loop back to replot slot
+    if (!prepareReplot()) // incase signals loop back to replot slot
         return;
+    paintLayers();
+    finishReplot(refreshPriority);
+}
+
+/*!
+  First phase of a replot, which must run on the GUI thread: emits \ref beforeReplot, lays out the
+  plot (emitting \ref afterLayout) and sets up the paint buffers.
+
+  Returns false, and does nothing, if this plot is already replotting. Otherwise \ref paintLayers
+  and \ref finishReplot must follow.
+
+  \see replot
+*/
+bool QCustomPlot::prepareReplot()
+{
+    if (mReplotting)
+        return false;
     mReplotting = true;
     mReplotQueued = false;
     emit beforeReplot();
-
-# if QT_VERSION < QT_VERSION_CHECK(4, 8, 0)
-    QTime replotTimer;
-    replotTimer.start();
-# else
-    QElapsedTimer replotTimer;
-    replotTimer.start();
-# endif
+    mReplotTimer.start();
 
     updateLayout();
-    // draw all layered objects (grid, axes, plottables, items, legend,...) into their buffers:
     setupPaintBuffers();
+    return true;
+}
+
+/*!
+  Second phase of a replot: draws all layered objects (grid, axes, plottables, items, legend,...)
+  into their paint buffers.
+
+  This only touches the layerables and paint buffers of this plot, so with \ref
+  setThreadedPainting enabled it may run on a worker thread, provided the GUI thread leaves the
+  plot and everything it draws alone until the phase is done. Several plots can thus paint their
+  layers at the same time.
+
+  \see prepareReplot, finishReplot
+*/
+void QCustomPlot::paintLayers()
+{
     foreach (QCPLayer *layer, mLayers)
         layer->drawToPaintBuffer();
     foreach (QSharedPointer<QCPAbstractPaintBuffer> buffer, mPaintBuffers)
         buffer->setInvalidated(false);
+}
+
+/*!
+  Last phase of a replot, which must run on the GUI thread: refreshes the widget surface with the
+  new buffer contents according to \a refreshPriority and emits \ref afterReplot.
 
+  \see prepareReplot, paintLayers
+*/
+void QCustomPlot::finishReplot(QCustomPlot::RefreshPriority refreshPriority)
+{
     if ((refreshPriority == rpRefreshHint && mPlottingHints.testFlag(QCP::phImmediateRefresh)) || refreshPriority==rpImmediateRefresh)
         repaint();
     else
         update();
 
 # if QT_VERSION < QT_VERSION_CHECK(4, 8, 0)
-    mReplotTime = replotTimer.elapsed();
+    mReplotTime = mReplotTimer.elapsed();
 # else
-    mReplotTime = replotTimer.nsecsElapsed()*1e-6;
+    mReplotTime = mReplotTimer.nsecsElapsed()*1e-6;
 # endif
     if (!qFuzzyIsNull(mReplotTimeAverage))
         mReplotTimeAverage = mReplotTimeAverage*0.9 + mReplotTime*0.1; // exponential moving average with a time constant of 10 last replots
@@ -15878,9 +16013,9 @@ void QCustomPlot::setupPaintBuffers()
 
   This method is used by \ref setupPaintBuffers when it needs to create new paint buffers.
 
-  Depending on the current setting of \ref setOpenGl, and the current Qt version, different
-  backends (subclasses of \ref QCPAbstractPaintBuffer) are created, initialized with the proper
-  size and device pixel ratio, and returned.
+  Depending on the current settings of \ref setOpenGl and \ref setThreadedPainting, and the
+  current Qt version, different backends (subclasses of \ref QCPAbstractPaintBuffer) are created,
+  initialized with the proper size and device pixel ratio, and returned.
 */
 QCPAbstractPaintBuffer *QCustomPlot::createPaintBuffer()
 {
@@ -15894,7 +16029,9 @@ QCPAbstractPaintBuffer *QCustomPlot::createPaintBuffer()
         qDebug() << Q_FUNC_INFO << "OpenGL enabled even though no support for it compiled in, this shouldn't have happened. Falling back to pixmap paint buffer.";
         return new QCPPaintBufferPixmap(viewport().size(), mBufferDevicePixelRatio);
 #endif
-    } else
+    } else if (mThreadedPainting)
+        return new QCPPaintBufferImage(viewport().size(), mBufferDevicePixelRatio);
+    else
         return new QCPPaintBufferPixmap(viewport().size(), mBufferDevicePixelRatio);
 }
 
@@ -16495,6 +16632,37 @@ void QCustomPlot::toPainter(QCPPainter *painter, int width, int height)
     } else
         qDebug() << Q_FUNC_INFO << "Passed painter is not active";
 }
+
+/*!
+  Returns the contents of the paint buffers as of the last replot, composited on the background
+  like the widget surface is in the paint event. The image has the viewport's size, times the
+  buffer device pixel ratio.
+
+  Unlike \ref toPixmap, this does not lay out or draw the plot again. With \ref
+  setThreadedPainting enabled (and no background pixmap set) it only works on QImages, so it may
+  be called from any thread, e.g. straight after \ref paintLayers on the same worker thread.
+
+  \see replot, prepareReplot, paintLayers
+*/
+QImage QCustomPlot::bufferImage()
+{
+    QImage result(mViewport.size()*mBufferDevicePixelRatio, QImage::Format_ARGB32_Premultiplied);
+#ifdef QCP_DEVICEPIXELRATIO_SUPPORTED
+    result.setDevicePixelRatio(mBufferDevicePixelRatio);
+#endif
+    result.fill(mBackgroundBrush.style() == Qt::SolidPattern ? mBackgroundBrush.color() : Qt::transparent);
+    QCPPainter painter(&result);
+    if (painter.isActive())
+    {
+        if (mBackgroundBrush.style() != Qt::SolidPattern && mBackgroundBrush.style() != Qt::NoBrush)
+            painter.fillRect(QRect(QPoint(0, 0), mViewport.size()), mBackgroundBrush);
+        drawBackground(&painter);
+        foreach (QSharedPointer<QCPAbstractPaintBuffer> buffer, mPaintBuffers)
+            buffer->draw(&painter);
+    } else // might happen if the viewport has width or height zero
+        qDebug() << Q_FUNC_INFO << "Couldn't activate painter on image";
+    return result;
+}
 /* end of 'src/core.cpp' */
 
 
@@ -18697,7 +18865,7 @@ void QCPAxisRect::wheelEvent(QWheelEvent *event)
                         axis->scaleRange(factor, axis->pixelToCoord(pos.y()));
                 }
             }
-            mParentPlot->replot();
+            mParentPlot->replot(QCustomPlot::rpQueuedReplot); // a fast wheel delivers several steps per frame
         }
     }
 }
@@ -21126,7 +21294,7 @@ QCPRange QCPGraph::getValueRange(bool &foundRange, QCP::SignDomain inSignDomain,
 void QCPGraph::draw(QCPPainter *painter)
 {
     if (!mKeyAxis || !mValueAxis) { qDebug() << Q_FUNC_INFO << "invalid key or value axis"; return; }
-    if (mKeyAxis.data()->range().size() <= 0 || mDataContainer->isEmpty()) return;
+    if (mKeyAxis.data()->range().size() <= 0 || dataCount() == 0) return; // dataCount, as subclasses may hold their data elsewhere
     if (mLineStyle == lsNone && mScatterStyle.isNone()) return;
 
     QVector<QPointF> lines, scatters; // line and (if necessary) scatter pixel coordinates will be stored here while iterating over segments
@@ -21260,6 +21428,20 @@ void QCPGraph::getLines(QVector<QPointF> *lines, const QCPDataRange &dataRange)
     if (mLineStyle != lsNone)
         getOptimizedLineData(&lineData, begin, end);
 
+    lineDataToLines(lines, lineData);
+}
+
+/*! \internal
+
+  Converts the optimized data points \a lineData (see \ref getOptimizedLineData) to pixel
+  coordinates appropriate to the line style, and returns them in \a lines. \a lineData may be
+  reordered in the process.
+
+  This is the part of \ref getLines that doesn't depend on where the data points come from, so
+  subclasses with a different data source (see \ref QCPColumnGraph) can share it.
+*/
+void QCPGraph::lineDataToLines(QVector<QPointF> *lines, QVector<QCPGraphData> &lineData) const
+{
     if (mKeyAxis->rangeReversed() != (mKeyAxis->orientation() == Qt::Vertical)) // make sure key pixels are sorted ascending in lineData (significantly simplifies following processing)
         std::reverse(lineData.begin(), lineData.end());
 
@@ -21304,6 +21486,22 @@ void QCPGraph::getScatters(QVector<QPointF> *scatters, const QCPDataRange &dataR
     QVector<QCPGraphData> data;
     getOptimizedScatterData(&data, begin, end);
 
+    scatterDataToPixels(scatters, data);
+}
+
+/*! \internal
+
+  Converts the optimized data points \a data (see \ref getOptimizedScatterData) to pixel
+  coordinates and returns them in \a scatters. \a data may be reordered in the process.
+
+  This is the part of \ref getScatters that doesn't depend on where the data points come from, so
+  subclasses with a different data source (see \ref QCPColumnGraph) can share it.
+*/
+void QCPGraph::scatterDataToPixels(QVector<QPointF> *scatters, QVector<QCPGraphData> &data) const
+{
+    QCPAxis *keyAxis = mKeyAxis.data();
+    QCPAxis *valueAxis = mValueAxis.data();
+
     if (mKeyAxis->rangeReversed() != (mKeyAxis->orientation() == Qt::Vertical)) // make sure key pixels are sorted ascending in data (significantly simplifies following processing)
         std::reverse(data.begin(), data.end());
 
@@ -21694,6 +21892,17 @@ void QCPGraph::drawImpulsePlot(QCPPainter *painter, const QVector<QPointF> &line
   \see getOptimizedScatterData
 */
 void QCPGraph::getOptimizedLineData(QVector<QCPGraphData> *lineData, const QCPGraphDataContainer::const_iterator &begin, const QCPGraphDataContainer::const_iterator &end) const
+{
+    optimizedLineData(lineData, begin, end);
+}
+
+/*! \internal
+
+  Implements \ref getOptimizedLineData for any random access iterator over \ref QCPGraphData, so
+  graphs that read their points from elsewhere (see \ref QCPColumnGraph) sample them the same way.
+*/
+template <class Iterator>
+void QCPGraph::optimizedLineData(QVector<QCPGraphData> *lineData, Iterator begin, Iterator end) const
 {
     if (!lineData) return;
     QCPAxis *keyAxis = mKeyAxis.data();
@@ -21712,10 +21921,10 @@ void QCPGraph::getOptimizedLineData(QVector<QCPGraphData> *lineData, const QCPGr
 
     if (mAdaptiveSampling && dataCount >= maxCount) // use adaptive sampling only if there are at least two points per pixel on average
     {
-        QCPGraphDataContainer::const_iterator it = begin;
+        Iterator it = begin;
         double minValue = it->value;
         double maxValue = it->value;
-        QCPGraphDataContainer::const_iterator currentIntervalFirstPoint = it;
+        Iterator currentIntervalFirstPoint = it;
         int reversedFactor = keyAxis->pixelOrientation(); // is used to calculate keyEpsilon pixel into the correct direction
         int reversedRound = reversedFactor==-1 ? 1 : 0; // is used to switch between floor (normal) and ceil (reversed) rounding of currentIntervalStartKey
         double currentIntervalStartKey = keyAxis->pixelToCoord(int(keyAxis->coordToPixel(begin->key)+reversedRound));
@@ -21786,6 +21995,17 @@ void QCPGraph::getOptimizedLineData(QVector<QCPGraphData> *lineData, const QCPGr
   \see getOptimizedLineData
 */
 void QCPGraph::getOptimizedScatterData(QVector<QCPGraphData> *scatterData, QCPGraphDataContainer::const_iterator begin, QCPGraphDataContainer::const_iterator end) const
+{
+    optimizedScatterData(scatterData, mDataContainer->constBegin(), begin, end);
+}
+
+/*! \internal
+
+  Implements \ref getOptimizedScatterData for any random access iterator over \ref QCPGraphData.
+  \a dataBegin is the first data point of the graph; scatter skipping counts from there.
+*/
+template <class Iterator>
+void QCPGraph::optimizedScatterData(QVector<QCPGraphData> *scatterData, Iterator dataBegin, Iterator begin, Iterator end) const
 {
     if (!scatterData) return;
     QCPAxis *keyAxis = mKeyAxis.data();
@@ -21794,8 +22014,8 @@ void QCPGraph::getOptimizedScatterData(QVector<QCPGraphData> *scatterData, QCPGr
 
     const int scatterModulo = mScatterSkip+1;
     const bool doScatterSkip = mScatterSkip > 0;
-    int beginIndex = int(begin-mDataContainer->constBegin());
-    int endIndex = int(end-mDataContainer->constBegin());
+    int beginIndex = int(begin-dataBegin);
+    int endIndex = int(end-dataBegin);
     while (doScatterSkip && begin != end && beginIndex % scatterModulo != 0) // advance begin iterator to first non-skipped scatter
     {
         ++beginIndex;
@@ -21814,13 +22034,13 @@ void QCPGraph::getOptimizedScatterData(QVector<QCPGraphData> *scatterData, QCPGr
     {
         double valueMaxRange = valueAxis->range().upper;
         double valueMinRange = valueAxis->range().lower;
-        QCPGraphDataContainer::const_iterator it = begin;
+        Iterator it = begin;
         int itIndex = int(beginIndex);
         double minValue = it->value;
         double maxValue = it->value;
-        QCPGraphDataContainer::const_iterator minValueIt = it;
-        QCPGraphDataContainer::const_iterator maxValueIt = it;
-        QCPGraphDataContainer::const_iterator currentIntervalStart = it;
+        Iterator minValueIt = it;
+        Iterator maxValueIt = it;
+        Iterator currentIntervalStart = it;
         int reversedFactor = keyAxis->pixelOrientation(); // is used to calculate keyEpsilon pixel into the correct direction
         int reversedRound = reversedFactor==-1 ? 1 : 0; // is used to switch between floor (normal) and ceil (reversed) rounding of currentIntervalStartKey
         double currentIntervalStartKey = keyAxis->pixelToCoord(int(keyAxis->coordToPixel(begin->key)+reversedRound));
@@ -21863,7 +22083,7 @@ void QCPGraph::getOptimizedScatterData(QVector<QCPGraphData> *scatterData, QCPGr
                     // determine value pixel span and add as many points in interval to maintain certain vertical data density (this is specific to scatter plot):
                     double valuePixelSpan = qAbs(valueAxis->coordToPixel(minValue)-valueAxis->coordToPixel(maxValue));
                     int dataModulo = qMax(1, qRound(intervalDataCount/(valuePixelSpan/4.0))); // approximately every 4 value pixels one data point on average
-                    QCPGraphDataContainer::const_iterator intervalIt = currentIntervalStart;
+                    Iterator intervalIt = currentIntervalStart;
                     int c = 0;
                     while (intervalIt != it)
                     {
@@ -21906,8 +22126,8 @@ void QCPGraph::getOptimizedScatterData(QVector<QCPGraphData> *scatterData, QCPGr
             // determine value pixel span and add as many points in interval to maintain certain vertical data density (this is specific to scatter plot):
             double valuePixelSpan = qAbs(valueAxis->coordToPixel(minValue)-valueAxis->coordToPixel(maxValue));
             int dataModulo = qMax(1, qRound(intervalDataCount/(valuePixelSpan/4.0))); // approximately every 4 value pixels one data point on average
-            QCPGraphDataContainer::const_iterator intervalIt = currentIntervalStart;
-            int intervalItIndex = int(intervalIt-mDataContainer->constBegin());
+            Iterator intervalIt = currentIntervalStart;
+            int intervalItIndex = int(intervalIt-dataBegin);
             int c = 0;
             while (intervalIt != it)
             {
@@ -21933,7 +22153,7 @@ void QCPGraph::getOptimizedScatterData(QVector<QCPGraphData> *scatterData, QCPGr
 
     } else // don't use adaptive sampling algorithm, transfer points one-to-one from the data container into the output
     {
-        QCPGraphDataContainer::const_iterator it = begin;
+        Iterator it = begin;
         int itIndex = beginIndex;
         scatterData->reserve(dataCount);
         while (it != end)
@@ -22410,19 +22630,14 @@ int QCPGraph::findIndexAboveY(const QVector<QPointF> *data, double y) const
 
 /*! \internal
 
-  Calculates the minimum distance in pixels the graph's representation has from the given \a
-  pixelPoint. This is used to determine whether the graph was clicked or not, e.g. in \ref
-  selectTest. The closest data point to \a pixelPoint is returned in \a closestData. Note that if
-  the graph has a line representation, the returned distance may be smaller than the distance to
-  the \a closestData point, since the distance to the graph line is also taken into account.
-
-  If either the graph has no data or if the line style is \ref lsNone and the scatter style's shape
-  is \ref QCPScatterStyle::ssNone (i.e. there is no visual representation of the graph), returns -1.0.
+  Implements \ref pointDistance for any data source with the search interface of \ref
+  QCPDataContainer (such as \ref QCPColumnData).
 */
-double QCPGraph::pointDistance(const QPointF &pixelPoint, QCPGraphDataContainer::const_iterator &closestData) const
+template <class Container>
+double QCPGraph::pointDistanceIn(const QPointF &pixelPoint, const Container &data, typename Container::const_iterator &closestData) const
 {
-    closestData = mDataContainer->constEnd();
-    if (mDataContainer->isEmpty())
+    closestData = data.constEnd();
+    if (data.isEmpty())
         return -1.0;
     if (mLineStyle == lsNone && mScatterStyle.isNone())
         return -1.0;
@@ -22436,9 +22651,9 @@ double QCPGraph::pointDistance(const QPointF &pixelPoint, QCPGraphDataContainer:
     if (posKeyMin > posKeyMax)
         qSwap(posKeyMin, posKeyMax);
     // iterate over found data points and then choose the one with the shortest distance to pos:
-    QCPGraphDataContainer::const_iterator begin = mDataContainer->findBegin(posKeyMin, true);
-    QCPGraphDataContainer::const_iterator end = mDataContainer->findEnd(posKeyMax, true);
-    for (QCPGraphDataContainer::const_iterator it=begin; it!=end; ++it)
+    typename Container::const_iterator begin = data.findBegin(posKeyMin, true);
+    typename Container::const_iterator end = data.findEnd(posKeyMax, true);
+    for (typename Container::const_iterator it=begin; it!=end; ++it)
     {
         const double currentDistSqr = QCPVector2D(coordsToPixels(it->key, it->value)-pixelPoint).lengthSquared();
         if (currentDistSqr < minDistSqr)
@@ -22467,6 +22682,22 @@ double QCPGraph::pointDistance(const QPointF &pixelPoint, QCPGraphDataContainer:
     return qSqrt(minDistSqr);
 }
 
+/*! \internal
+
+  Calculates the minimum distance in pixels the graph's representation has from the given \a
+  pixelPoint. This is used to determine whether the graph was clicked or not, e.g. in \ref
+  selectTest. The closest data point to \a pixelPoint is returned in \a closestData. Note that if
+  the graph has a line representation, the returned distance may be smaller than the distance to
+  the \a closestData point, since the distance to the graph line is also taken into account.
+
+  If either the graph has no data or if the line style is \ref lsNone and the scatter style's shape
+  is \ref QCPScatterStyle::ssNone (i.e. there is no visual representation of the graph), returns -1.0.
+*/
+double QCPGraph::pointDistance(const QPointF &pixelPoint, QCPGraphDataContainer::const_iterator &closestData) const
+{
+    return pointDistanceIn(pixelPoint, *mDataContainer, closestData);
+}
+
 /*! \internal
 
   Finds the highest index of \a data, whose points y value is just below \a y. Assumes y values in
@@ -22489,6 +22720,803 @@ int QCPGraph::findIndexBelowY(const QVector<QPointF> *data, double y) const
     }
     return -1;
 }
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////// QCPColumnData
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*! \class QCPColumnData
+  \brief A read-only view of graph data held in two external arrays
+
+  Where \ref QCPGraphDataContainer owns interleaved \ref QCPGraphData points, this class only
+  points at a key array and a value array of equal length that are owned elsewhere (e.g. the
+  columns of a dataset or of a memory-mapped file). Nothing is copied; the arrays must stay valid
+  and unchanged for as long as the view is in use, and the keys must be sorted ascending.
+
+  The search interface (\ref findBegin, \ref findEnd, \ref keyRange, \ref valueRange, \ref
+  limitIteratorsToDataRange) behaves like the one of \ref QCPDataContainer. Its \ref const_iterator
+  is a random access iterator that yields \ref QCPGraphData points by value.
+
+  \see QCPColumnGraph
+*/
+
+/*!
+  Constructs an empty view.
+*/
+QCPColumnData::QCPColumnData() :
+    mKeys(nullptr),
+    mValues(nullptr),
+    mSize(0)
+{
+}
+
+/*!
+  Constructs a view of the \a size points whose keys are in \a keys and whose values are in \a
+  values.
+*/
+QCPColumnData::QCPColumnData(const double *keys, const double *values, int size) :
+    mKeys(keys),
+    mValues(values),
+    mSize(keys && values ? size : 0)
+{
+}
+
+/*!
+  Returns an iterator to the data point with a key that is equal to, just below, or just above \a
+  sortKey. If \a expandedRange is true, the data point just below \a sortKey will be considered,
+  otherwise the one just above.
+
+  If the view is empty, returns \ref constEnd.
+
+  \see QCPDataContainer::findBegin
+*/
+QCPColumnData::const_iterator QCPColumnData::findBegin(double sortKey, bool expandedRange) const
+{
+    if (isEmpty())
+        return constEnd();
+
+    const_iterator it = constBegin() + (std::lower_bound(mKeys, mKeys+mSize, sortKey)-mKeys);
+    if (expandedRange && it != constBegin()) // also covers it == constEnd case, and we know --constEnd is valid because the view isn't empty
+        --it;
+    return it;
+}
+
+/*!
+  Returns an iterator to the element after the data point with a key that is equal to, just above
+  or just below \a sortKey. If \a expandedRange is true, the data point just above \a sortKey will
+  be considered, otherwise the one just below.
+
+  If the view is empty, \ref constEnd is returned.
+
+  \see QCPDataContainer::findEnd
+*/
+QCPColumnData::const_iterator QCPColumnData::findEnd(double sortKey, bool expandedRange) const
+{
+    if (isEmpty())
+        return constEnd();
+
+    const_iterator it = constBegin() + (std::upper_bound(mKeys, mKeys+mSize, sortKey)-mKeys);
+    if (expandedRange && it != constEnd())
+        ++it;
+    return it;
+}
+
+/*!
+  Returns the range encompassed by the keys of all data points with a non-NaN value. The output
+  parameter \a foundRange indicates whether a sensible range was found.
+
+  \see QCPDataContainer::keyRange
+*/
+QCPRange QCPColumnData::keyRange(bool &foundRange, QCP::SignDomain signDomain) const
+{
+    QCPRange range;
+    bool haveLower = false;
+    bool haveUpper = false;
+    if (signDomain == QCP::sdBoth) // keys are sorted, so just find the first and last key with non-NaN value
+    {
+        for (int i=0; i<mSize; ++i)
+        {
+            if (!qIsNaN(mValues[i]))
+            {
+                range.lower = mKeys[i];
+                haveLower = true;
+                break;
+            }
+        }
+        for (int i=mSize-1; i>=0; --i)
+        {
+            if (!qIsNaN(mValues[i]))
+            {
+                range.upper = mKeys[i];
+                haveUpper = true;
+                break;
+            }
+        }
+    } else // only one sign domain, go through all data points and accordingly expand range
+    {
+        for (int i=0; i<mSize; ++i)
+        {
+            const double current = mKeys[i];
+            if (qIsNaN(mValues[i]) || (signDomain == QCP::sdNegative ? current >= 0 : current <= 0))
+                continue;
+            if (current < range.lower || !haveLower)
+            {
+                range.lower = current;
+                haveLower = true;
+            }
+            if (current > range.upper || !haveUpper)
+            {
+                range.upper = current;
+                haveUpper = true;
+            }
+        }
+    }
+
+    foundRange = haveLower && haveUpper;
+    return range;
+}
+
+/*!
+  Returns the range encompassed by the values of the data points in the key range \a inKeyRange
+  (all data points if it is equal to <tt>QCPRange()</tt>). NaN, Inf and -Inf values are ignored.
+  The output parameter \a foundRange indicates whether a sensible range was found.
+
+  \see QCPDataContainer::valueRange
+*/
+QCPRange QCPColumnData::valueRange(bool &foundRange, QCP::SignDomain signDomain, const QCPRange &inKeyRange) const
+{
+    QCPRange range;
+    bool haveLower = false;
+    bool haveUpper = false;
+    int begin = 0;
+    int end = mSize;
+    if (inKeyRange != QCPRange())
+    {
+        begin = int(findBegin(inKeyRange.lower, false)-constBegin());
+        end = int(findEnd(inKeyRange.upper, false)-constBegin());
+    }
+    for (int i=begin; i<end; ++i)
+    {
+        const double current = mValues[i];
+        if (qIsNaN(current) || !std::isfinite(current))
+            continue;
+        if ((signDomain == QCP::sdNegative && current >= 0) || (signDomain == QCP::sdPositive && current <= 0))
+            continue;
+        if (current < range.lower || !haveLower)
+        {
+            range.lower = current;
+            haveLower = true;
+        }
+        if (current > range.upper || !haveUpper)
+        {
+            range.upper = current;
+            haveUpper = true;
+        }
+    }
+
+    foundRange = haveLower && haveUpper;
+    return range;
+}
+
+/*!
+  Makes sure \a begin and \a end mark a data range that is both within the bounds of this view, as
+  well as within the specified \a dataRange. The initial range described by the passed iterators
+  is never expanded, only contracted if necessary.
+
+  \see QCPDataContainer::limitIteratorsToDataRange
+*/
+void QCPColumnData::limitIteratorsToDataRange(const_iterator &begin, const_iterator &end, const QCPDataRange &dataRange) const
+{
+    QCPDataRange iteratorRange(int(begin-constBegin()), int(end-constBegin()));
+    iteratorRange = iteratorRange.bounded(dataRange.bounded(this->dataRange()));
+    begin = constBegin()+iteratorRange.begin();
+    end = constBegin()+iteratorRange.end();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////// QCPMinMaxPyramid
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*! \class QCPMinMaxPyramid
+  \brief Multi-resolution summary of sorted key/value data for fast line sampling
+
+  Level 0 holds one \ref Bucket per \ref baseBucketSize consecutive data points, each higher level
+  one bucket per \ref fanout buckets of the level below, up to a level with at most \ref fanout
+  buckets. A bucket stores the first and last point it covers and the minimum and maximum value in
+  between (NaN values are skipped; a bucket of only NaN values has NaN extremes).
+
+  When many data points fall on one pixel, a line plot only needs these four numbers per pixel.
+  \ref QCPColumnGraph therefore samples its line from the coarsest buckets that are still narrower
+  than a pixel, which makes the cost of a replot depend on the pixel width of the axis rather than
+  on the number of visible data points.
+
+  The pyramid only references the data while \ref build and \ref extend run, it doesn't keep
+  pointers to it. It takes about a quarter of the memory of the data it summarizes.
+*/
+
+/* start documentation of inline functions */
+
+/*! \fn int QCPMinMaxPyramid::size() const
+
+  Returns the number of data points summarized by the pyramid.
+*/
+
+/*! \fn const QVector<Bucket> &QCPMinMaxPyramid::level(int index) const
+
+  Returns the buckets of level \a index. Bucket \a i of a level covers the data points starting at
+  index <tt>i*bucketSize(level)</tt>; the last bucket of a level may cover fewer points.
+*/
+
+/* end documentation of inline functions */
+
+const int QCPMinMaxPyramid::baseBucketSize;
+const int QCPMinMaxPyramid::fanout;
+
+/*!
+  Constructs an empty pyramid.
+*/
+QCPMinMaxPyramid::QCPMinMaxPyramid() :
+    mSize(0)
+{
+}
+
+/*!
+  Returns the number of data points covered by a (full) bucket of \a level.
+*/
+int QCPMinMaxPyramid::bucketSize(int level) const
+{
+    int result = baseBucketSize;
+    for (int i=0; i<level; ++i)
+        result *= fanout;
+    return result;
+}
+
+/*!
+  Removes all levels.
+*/
+void QCPMinMaxPyramid::clear()
+{
+    mLevels.clear();
+    mSize = 0;
+}
+
+/*!
+  Rebuilds the pyramid for the \a size data points in \a keys and \a values.
+
+  \see extend
+*/
+void QCPMinMaxPyramid::build(const double *keys, const double *values, int size)
+{
+    clear();
+    extend(keys, values, size);
+}
+
+/*!
+  Updates the pyramid after data points were appended. The first \ref size points of \a keys and
+  \a values must be the ones the pyramid was built from (the arrays themselves may have moved).
+  Only the buckets covering the new points are recomputed, so appending is cheap regardless of how
+  much data came before.
+
+  If \a size is smaller than \ref size, the pyramid is rebuilt.
+*/
+void QCPMinMaxPyramid::extend(const double *keys, const double *values, int size)
+{
+    if (size < mSize)
+    {
+        build(keys, values, size);
+        return;
+    }
+    if (size == mSize || !keys || !values)
+        return;
+
+    const int firstChangedPoint = mSize;
+    mSize = size;
+    update(keys, values, firstChangedPoint);
+}
+
+/*! \internal
+
+  Recomputes all buckets covering data points from index \a firstChangedPoint on, in every level,
+  and adds levels until the top one has at most \ref fanout buckets.
+*/
+void QCPMinMaxPyramid::update(const double *keys, const double *values, int firstChangedPoint)
+{
+    // level 0 summarizes the data points:
+    if (mLevels.isEmpty())
+        mLevels.append(QVector<Bucket>());
+    QVector<Bucket> &base = mLevels[0];
+    base.resize((mSize+baseBucketSize-1)/baseBucketSize);
+    int firstBucket = firstChangedPoint/baseBucketSize;
+    for (int b=firstBucket; b<base.size(); ++b)
+    {
+        const int begin = b*baseBucketSize;
+        const int end = qMin(begin+baseBucketSize, mSize);
+        Bucket &bucket = base[b];
+        bucket.firstKey = keys[begin];
+        bucket.lastKey = keys[end-1];
+        bucket.firstValue = values[begin];
+        bucket.lastValue = values[end-1];
+        bucket.minValue = qQNaN();
+        bucket.maxValue = qQNaN();
+        for (int i=begin; i<end; ++i)
+        {
+            const double value = values[i];
+            if (qIsNaN(value))
+                continue;
+            if (qIsNaN(bucket.minValue) || value < bucket.minValue)
+                bucket.minValue = value;
+            if (qIsNaN(bucket.maxValue) || value > bucket.maxValue)
+                bucket.maxValue = value;
+        }
+    }
+
+    // every higher level summarizes the one below:
+    for (int level=1; mLevels.at(level-1).size() > fanout; ++level)
+    {
+        if (level == mLevels.size())
+        {
+            mLevels.append(QVector<Bucket>());
+            firstBucket = 0;
+        } else
+            firstBucket /= fanout;
+        QVector<Bucket> &buckets = mLevels[level];
+        const QVector<Bucket> &children = mLevels.at(level-1);
+        buckets.resize((children.size()+fanout-1)/fanout);
+        for (int b=firstBucket; b<buckets.size(); ++b)
+        {
+            const int begin = b*fanout;
+            const int end = qMin(begin+fanout, children.size());
+            Bucket bucket = children.at(begin);
+            for (int c=begin+1; c<end; ++c)
+            {
+                const Bucket &child = children.at(c);
+                bucket.lastKey = child.lastKey;
+                bucket.lastValue = child.lastValue;
+                if (qIsNaN(bucket.minValue) || child.minValue < bucket.minValue)
+                    bucket.minValue = child.minValue;
+                if (qIsNaN(bucket.maxValue) || child.maxValue > bucket.maxValue)
+                    bucket.maxValue = child.maxValue;
+            }
+            buckets[b] = bucket;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////// QCPColumnGraph
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*! \class QCPColumnGraph
+  \brief A graph that draws its data straight from external key and value arrays
+
+  QCPColumnGraph looks and behaves like \ref QCPGraph (line and scatter styles, adaptive sampling,
+  fills, selection), but instead of copying the points into a \ref QCPGraphDataContainer it reads
+  them through a \ref QCPColumnData view, see \ref setColumns. This avoids holding a second copy
+  of large datasets.
+
+  The arrays stay owned by the caller: they must outlive the graph, or be replaced with another
+  \ref setColumns call before they are freed or reallocated (e.g. after appending to them). The
+  keys must be sorted ascending. The data container inherited from \ref QCPGraph is not drawn, so
+  \ref QCPGraph::setData and \ref QCPGraph::addData have no visible effect on this graph.
+
+  With adaptive sampling enabled (the default), the graph keeps a \ref QCPMinMaxPyramid of its data
+  and samples the line from it on linear key axes, so zoomed out views of millions of points
+  replot in time proportional to the axis width. The pyramid is built by \ref setColumns and
+  updated incrementally by \ref appendColumns.
+
+  Like QCPGraph, it registers itself with the QCustomPlot of \a keyAxis on construction, so it is
+  accessible via \ref QCustomPlot::graph.
+*/
+
+/*!
+  Constructs a graph which uses \a keyAxis as its key axis ("x") and \a valueAxis as its value
+  axis ("y"), see \ref QCPGraph::QCPGraph. The graph initially views no data.
+*/
+QCPColumnGraph::QCPColumnGraph(QCPAxis *keyAxis, QCPAxis *valueAxis) :
+    QCPGraph(keyAxis, valueAxis)
+{
+}
+
+QCPColumnGraph::~QCPColumnGraph()
+{
+}
+
+/*!
+  Makes the graph show the \a size points whose keys are in \a keys (sorted ascending) and whose
+  values are in \a values, without copying them. Call this again whenever the arrays move or
+  grow.
+*/
+void QCPColumnGraph::setColumns(const double *keys, const double *values, int size)
+{
+    mColumns = QCPColumnData(keys, values, size);
+    mPyramid.build(mColumns.keys(), mColumns.values(), mColumns.size());
+}
+
+/*!
+  Like \ref setColumns, for arrays that start with the points the graph viewed so far, e.g. the
+  same columns after rows were appended to them (they may have been reallocated in the process).
+  Only the new points are added to the sampling pyramid.
+*/
+void QCPColumnGraph::appendColumns(const double *keys, const double *values, int size)
+{
+    mColumns = QCPColumnData(keys, values, size);
+    mPyramid.extend(mColumns.keys(), mColumns.values(), mColumns.size());
+}
+
+/* inherits documentation from base class */
+int QCPColumnGraph::dataCount() const
+{
+    return mColumns.size();
+}
+
+/* inherits documentation from base class */
+double QCPColumnGraph::dataMainKey(int index) const
+{
+    if (index >= 0 && index < mColumns.size())
+    {
+        return mColumns.keys()[index];
+    } else
+    {
+        qDebug() << Q_FUNC_INFO << "Index out of bounds" << index;
+        return 0;
+    }
+}
+
+/* inherits documentation from base class */
+double QCPColumnGraph::dataSortKey(int index) const
+{
+    return dataMainKey(index);
+}
+
+/* inherits documentation from base class */
+double QCPColumnGraph::dataMainValue(int index) const
+{
+    if (index >= 0 && index < mColumns.size())
+    {
+        return mColumns.values()[index];
+    } else
+    {
+        qDebug() << Q_FUNC_INFO << "Index out of bounds" << index;
+        return 0;
+    }
+}
+
+/* inherits documentation from base class */
+QCPRange QCPColumnGraph::dataValueRange(int index) const
+{
+    if (index >= 0 && index < mColumns.size())
+    {
+        return QCPRange(mColumns.values()[index], mColumns.values()[index]);
+    } else
+    {
+        qDebug() << Q_FUNC_INFO << "Index out of bounds" << index;
+        return QCPRange(0, 0);
+    }
+}
+
+/* inherits documentation from base class */
+QPointF QCPColumnGraph::dataPixelPosition(int index) const
+{
+    if (index >= 0 && index < mColumns.size())
+    {
+        return coordsToPixels(mColumns.keys()[index], mColumns.values()[index]);
+    } else
+    {
+        qDebug() << Q_FUNC_INFO << "Index out of bounds" << index;
+        return QPointF();
+    }
+}
+
+/* inherits documentation from base class */
+QCPDataSelection QCPColumnGraph::selectTestRect(const QRectF &rect, bool onlySelectable) const
+{
+    QCPDataSelection result;
+    if ((onlySelectable && mSelectable == QCP::stNone) || mColumns.isEmpty())
+        return result;
+    if (!mKeyAxis || !mValueAxis)
+        return result;
+
+    // convert rect given in pixels to ranges given in plot coordinates:
+    double key1, value1, key2, value2;
+    pixelsToCoords(rect.topLeft(), key1, value1);
+    pixelsToCoords(rect.bottomRight(), key2, value2);
+    QCPRange keyRange(key1, key2); // QCPRange normalizes internally so we don't have to care about whether key1 < key2
+    QCPRange valueRange(value1, value2);
+    const int begin = int(mColumns.findBegin(keyRange.lower, false)-mColumns.constBegin());
+    const int end = int(mColumns.findEnd(keyRange.upper, false)-mColumns.constBegin());
+
+    int currentSegmentBegin = -1; // -1 means we're currently not in a segment that's contained in rect
+    for (int i=begin; i<end; ++i)
+    {
+        const bool contained = valueRange.contains(mColumns.values()[i]) && keyRange.contains(mColumns.keys()[i]);
+        if (currentSegmentBegin == -1)
+        {
+            if (contained) // start segment
+                currentSegmentBegin = i;
+        } else if (!contained) // segment just ended
+        {
+            result.addDataRange(QCPDataRange(currentSegmentBegin, i), false);
+            currentSegmentBegin = -1;
+        }
+    }
+    // process potential last segment:
+    if (currentSegmentBegin != -1)
+        result.addDataRange(QCPDataRange(currentSegmentBegin, end), false);
+
+    result.simplify();
+    return result;
+}
+
+/* inherits documentation from base class */
+int QCPColumnGraph::findBegin(double sortKey, bool expandedRange) const
+{
+    return int(mColumns.findBegin(sortKey, expandedRange)-mColumns.constBegin());
+}
+
+/* inherits documentation from base class */
+int QCPColumnGraph::findEnd(double sortKey, bool expandedRange) const
+{
+    return int(mColumns.findEnd(sortKey, expandedRange)-mColumns.constBegin());
+}
+
+/* inherits documentation from base class */
+double QCPColumnGraph::selectTest(const QPointF &pos, bool onlySelectable, QVariant *details) const
+{
+    if ((onlySelectable && mSelectable == QCP::stNone) || mColumns.isEmpty())
+        return -1;
+    if (!mKeyAxis || !mValueAxis)
+        return -1;
+
+    if (mKeyAxis.data()->axisRect()->rect().contains(pos.toPoint()) || mParentPlot->interactions().testFlag(QCP::iSelectPlottablesBeyondAxisRect))
+    {
+        QCPColumnData::const_iterator closestDataPoint = mColumns.constEnd();
+        double result = pointDistanceIn(pos, mColumns, closestDataPoint);
+        if (details)
+        {
+            int pointIndex = int(closestDataPoint-mColumns.constBegin());
+            details->setValue(QCPDataSelection(QCPDataRange(pointIndex, pointIndex+1)));
+        }
+        return result;
+    } else
+        return -1;
+}
+
+/* inherits documentation from base class */
+QCPRange QCPColumnGraph::getKeyRange(bool &foundRange, QCP::SignDomain inSignDomain) const
+{
+    return mColumns.keyRange(foundRange, inSignDomain);
+}
+
+/* inherits documentation from base class */
+QCPRange QCPColumnGraph::getValueRange(bool &foundRange, QCP::SignDomain inSignDomain, const QCPRange &inKeyRange) const
+{
+    return mColumns.valueRange(foundRange, inSignDomain, inKeyRange);
+}
+
+/*! \internal
+
+  Consolidates consecutive runs of data points (single points or \ref QCPMinMaxPyramid::Bucket
+  "buckets") that fall on the same pixel, like the adaptive sampling of \ref
+  QCPGraph::getOptimizedLineData does for single points, and appends the resulting line points to
+  \a lineData.
+*/
+struct QCPColumnGraph::LineSampler
+{
+    QVector<QCPGraphData> *lineData;
+    QCPAxis *keyAxis;
+    double keyEpsilon; // interval of one pixel on screen when mapped to plot key coordinates
+    int reversedRound; // is used to switch between floor (normal) and ceil (reversed) rounding of intervalStartKey
+    bool started;
+    double intervalStartKey, lastIntervalEndKey;
+    double firstKey, firstValue, lastKey, lastValue, minValue, maxValue; // of the current pixel interval
+    int intervalDataCount;
+
+    void addPoint(double key, double value)
+    {
+        const QCPMinMaxPyramid::Bucket point = {key, key, value, value, value, value};
+        add(point, 1);
+    }
+
+    void add(const QCPMinMaxPyramid::Bucket &run, int runDataCount)
+    {
+        if (!started)
+        {
+            start(run, runDataCount);
+            lastIntervalEndKey = intervalStartKey;
+            started = true;
+        } else if (run.firstKey < intervalStartKey+keyEpsilon) // run is still within same pixel, so expand value span of this cluster if necessary
+        {
+            if (qIsNaN(minValue) || run.minValue < minValue)
+                minValue = run.minValue;
+            if (qIsNaN(maxValue) || run.maxValue > maxValue)
+                maxValue = run.maxValue;
+            lastKey = run.lastKey;
+            lastValue = run.lastValue;
+            intervalDataCount += runDataCount;
+        } else // new pixel interval started
+        {
+            finishInterval(run.firstKey);
+            lastIntervalEndKey = lastKey;
+            start(run, runDataCount);
+        }
+    }
+
+    void finish()
+    {
+        if (started)
+            finishInterval(qQNaN());
+    }
+
+    bool fitsOnePixel(const QCPMinMaxPyramid::Bucket &run) const // i.e. adding the run's points one by one would put them into one cluster
+    {
+        return run.lastKey < keyAxis->pixelToCoord(int(keyAxis->coordToPixel(run.firstKey)+reversedRound))+keyEpsilon;
+    }
+
+    void start(const QCPMinMaxPyramid::Bucket &run, int runDataCount)
+    {
+        firstKey = run.firstKey;
+        firstValue = run.firstValue;
+        lastKey = run.lastKey;
+        lastValue = run.lastValue;
+        minValue = run.minValue;
+        maxValue = run.maxValue;
+        intervalDataCount = runDataCount;
+        intervalStartKey = keyAxis->pixelToCoord(int(keyAxis->coordToPixel(run.firstKey)+reversedRound));
+    }
+
+    void finishInterval(double nextKey)
+    {
+        if (intervalDataCount >= 2) // pixel had multiple data points, consolidate them to a cluster
+        {
+            if (lastIntervalEndKey < intervalStartKey-keyEpsilon) // last point is further away, so first point of this cluster must be at a real data point
+                lineData->append(QCPGraphData(intervalStartKey+keyEpsilon*0.2, firstValue));
+            lineData->append(QCPGraphData(intervalStartKey+keyEpsilon*0.25, minValue));
+            lineData->append(QCPGraphData(intervalStartKey+keyEpsilon*0.75, maxValue));
+            if (nextKey > intervalStartKey+keyEpsilon*2) // next pixel starts further away from this cluster, so make sure the last point of the cluster is at a real data point
+                lineData->append(QCPGraphData(intervalStartKey+keyEpsilon*0.8, lastValue));
+        } else
+            lineData->append(QCPGraphData(firstKey, firstValue));
+    }
+};
+
+/*! \internal
+
+  Same as \ref QCPGraph::getLines, reading the data points through the column view.
+*/
+void QCPColumnGraph::getLines(QVector<QPointF> *lines, const QCPDataRange &dataRange) const
+{
+    if (!lines) return;
+    QCPColumnData::const_iterator begin, end;
+    getVisibleDataBounds(begin, end, dataRange);
+    if (begin == end)
+    {
+        lines->clear();
+        return;
+    }
+
+    QVector<QCPGraphData> lineData;
+    if (mLineStyle != lsNone && !getPyramidLineData(&lineData, int(begin-mColumns.constBegin()), int(end-mColumns.constBegin())))
+        optimizedLineData(&lineData, begin, end);
+
+    lineDataToLines(lines, lineData);
+}
+
+/*! \internal
+
+  Same as \ref QCPGraph::getScatters, reading the data points through the column view.
+*/
+void QCPColumnGraph::getScatters(QVector<QPointF> *scatters, const QCPDataRange &dataRange) const
+{
+    if (!scatters) return;
+    if (!mKeyAxis || !mValueAxis) { qDebug() << Q_FUNC_INFO << "invalid key or value axis"; scatters->clear(); return; }
+
+    QCPColumnData::const_iterator begin, end;
+    getVisibleDataBounds(begin, end, dataRange);
+    if (begin == end)
+    {
+        scatters->clear();
+        return;
+    }
+
+    QVector<QCPGraphData> data;
+    optimizedScatterData(&data, mColumns.constBegin(), begin, end);
+
+    scatterDataToPixels(scatters, data);
+}
+
+/*! \internal
+
+  Same as \ref QCPGraph::getVisibleDataBounds, for the column view.
+*/
+void QCPColumnGraph::getVisibleDataBounds(QCPColumnData::const_iterator &begin, QCPColumnData::const_iterator &end, const QCPDataRange &rangeRestriction) const
+{
+    if (rangeRestriction.isEmpty())
+    {
+        end = mColumns.constEnd();
+        begin = end;
+    } else
+    {
+        QCPAxis *keyAxis = mKeyAxis.data();
+        QCPAxis *valueAxis = mValueAxis.data();
+        if (!keyAxis || !valueAxis) { qDebug() << Q_FUNC_INFO << "invalid key or value axis"; return; }
+        // get visible data range:
+        begin = mColumns.findBegin(keyAxis->range().lower);
+        end = mColumns.findEnd(keyAxis->range().upper);
+        // limit lower/upperEnd to rangeRestriction:
+        mColumns.limitIteratorsToDataRange(begin, end, rangeRestriction); // this also ensures rangeRestriction outside data bounds doesn't break anything
+    }
+}
+
+/*! \internal
+
+  Adaptive sampling of the line data between the data indices \a begin and \a end using \ref
+  mPyramid: runs of data points within one pixel are taken from the coarsest pyramid level that
+  has them, so only a few buckets per pixel are visited. The resulting line is the one \ref
+  QCPGraph::getOptimizedLineData computes from the single points.
+
+  Returns false (and leaves \a lineData untouched) if adaptive sampling is disabled, the key axis
+  isn't linear, or the visible data is sparse enough to be drawn point by point.
+*/
+bool QCPColumnGraph::getPyramidLineData(QVector<QCPGraphData> *lineData, int begin, int end) const
+{
+    QCPAxis *keyAxis = mKeyAxis.data();
+    if (!mAdaptiveSampling || !keyAxis || keyAxis->scaleType() != QCPAxis::stLinear || mPyramid.size() != mColumns.size() || begin >= end)
+        return false;
+
+    const double *keys = mColumns.keys();
+    const double keyPixelSpan = qAbs(keyAxis->coordToPixel(keys[begin])-keyAxis->coordToPixel(keys[end-1]));
+    if (end-begin < 2*keyPixelSpan+2) // fewer than two points per pixel on average, no sampling needed
+        return false;
+
+    LineSampler sampler;
+    sampler.lineData = lineData;
+    sampler.keyAxis = keyAxis;
+    sampler.reversedRound = keyAxis->pixelOrientation()==-1 ? 1 : 0;
+    const double startKey = keyAxis->pixelToCoord(int(keyAxis->coordToPixel(keys[begin])+sampler.reversedRound));
+    sampler.keyEpsilon = qAbs(startKey-keyAxis->pixelToCoord(keyAxis->coordToPixel(startKey)+1.0*keyAxis->pixelOrientation()));
+    sampler.started = false;
+
+    const int topLevel = mPyramid.levelCount()-1;
+    const int topBucketSize = mPyramid.bucketSize(topLevel);
+    for (int bucket=begin/topBucketSize; bucket*topBucketSize < end; ++bucket)
+        samplePyramidRange(sampler, topLevel, bucket, begin, end);
+    sampler.finish();
+    return true;
+}
+
+/*! \internal
+
+  Feeds the data points of \a bucket in pyramid \a level that lie between the data indices \a
+  begin and \a end to \a sampler: the whole bucket at once if it is completely inside and within
+  one pixel, otherwise its children (or, in level 0, its data points).
+*/
+void QCPColumnGraph::samplePyramidRange(LineSampler &sampler, int level, int bucket, int begin, int end) const
+{
+    const int bucketSize = mPyramid.bucketSize(level);
+    const int first = bucket*bucketSize;
+    const int last = qMin(first+bucketSize, mColumns.size());
+    const QCPMinMaxPyramid::Bucket &summary = mPyramid.level(level).at(bucket);
+    if (begin <= first && last <= end && sampler.fitsOnePixel(summary))
+    {
+        sampler.add(summary, last-first);
+    } else if (level == 0)
+    {
+        const double *keys = mColumns.keys();
+        const double *values = mColumns.values();
+        const int pointsEnd = qMin(last, end);
+        for (int i=qMax(first, begin); i<pointsEnd; ++i)
+            sampler.addPoint(keys[i], values[i]);
+    } else
+    {
+        const int childSize = bucketSize/QCPMinMaxPyramid::fanout;
+        const int childrenEnd = qMin(last, end);
+        for (int child=qMax(first, begin)/childSize; child*childSize < childrenEnd; ++child)
+            samplePyramidRange(sampler, level-1, child, begin, end);
+    }
+}
 /* end of 'src/plottables/plottable-graph.cpp' */
 
 
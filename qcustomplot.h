@@ -69,6 +69,7 @@
 #include <qmath.h>
 #include <limits>
 #include <algorithm>
+#include <iterator>
 #ifdef QCP_OPENGL_FBO
 #  include <QtGui/QOpenGLContext>
 #  if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
@@ -626,6 +627,26 @@ protected:
 };
 
 
+class QCP_LIB_DECL QCPPaintBufferImage : public QCPAbstractPaintBuffer
+{
+public:
+    explicit QCPPaintBufferImage(const QSize &size, double devicePixelRatio);
+    virtual ~QCPPaintBufferImage() Q_DECL_OVERRIDE;
+
+    // reimplemented virtual methods:
+    virtual QCPPainter *startPainting() Q_DECL_OVERRIDE;
+    virtual void draw(QCPPainter *painter) const Q_DECL_OVERRIDE;
+    void clear(const QColor &color) Q_DECL_OVERRIDE;
+
+protected:
+    // non-property members:
+    QImage mBuffer;
+
+    // reimplemented virtual methods:
+    virtual void reallocateBuffer() Q_DECL_OVERRIDE;
+};
+
+
 #ifdef QCP_OPENGL_PBUFFER
 class QCP_LIB_DECL QCPPaintBufferGlPbuffer : public QCPAbstractPaintBuffer
 {
@@ -3846,6 +3867,7 @@ public:
     QCP::SelectionRectMode selectionRectMode() const { return mSelectionRectMode; }
     QCPSelectionRect *selectionRect() const { return mSelectionRect; }
     bool openGl() const { return mOpenGl; }
+    bool threadedPainting() const { return mThreadedPainting; }
 
     // setters:
     void setViewport(const QRect &rect);
@@ -3870,6 +3892,7 @@ public:
     void setSelectionRectMode(QCP::SelectionRectMode mode);
     void setSelectionRect(QCPSelectionRect *selectionRect);
     void setOpenGl(bool enabled, int multisampling=16);
+    void setThreadedPainting(bool enabled);
 
     // non-property methods:
     // plottable interface:
@@ -3938,7 +3961,11 @@ public:
     bool saveRastered(const QString &fileName, int width, int height, double scale, const char *format, int quality=-1, int resolution=96, QCP::ResolutionUnit resolutionUnit=QCP::ruDotsPerInch);
     QPixmap toPixmap(int width=0, int height=0, double scale=1.0);
     void toPainter(QCPPainter *painter, int width=0, int height=0);
+    QImage bufferImage();
     Q_SLOT void replot(QCustomPlot::RefreshPriority refreshPriority=QCustomPlot::rpRefreshHint);
+    bool prepareReplot();
+    void paintLayers();
+    void finishReplot(QCustomPlot::RefreshPriority refreshPriority=QCustomPlot::rpRefreshHint);
     double replotTime(bool average=false) const;
 
     QCPAxis *xAxis, *yAxis, *xAxis2, *yAxis2;
@@ -3990,6 +4017,7 @@ protected:
     QCP::SelectionRectMode mSelectionRectMode;
     QCPSelectionRect *mSelectionRect;
     bool mOpenGl;
+    bool mThreadedPainting;
 
     // non-property members:
     QList<QSharedPointer<QCPAbstractPaintBuffer> > mPaintBuffers;
@@ -4002,6 +4030,11 @@ protected:
     bool mReplotting;
     bool mReplotQueued;
     double mReplotTime, mReplotTimeAverage;
+#if QT_VERSION < QT_VERSION_CHECK(4, 8, 0)
+    QTime mReplotTimer;
+#else
+    QElapsedTimer mReplotTimer;
+#endif
     int mOpenGlMultisamples;
     QCP::AntialiasedElements mOpenGlAntialiasedElementsBackup;
     bool mOpenGlCacheLabelsBackup;
@@ -5491,6 +5524,121 @@ Q_DECLARE_TYPEINFO(QCPGraphData, Q_PRIMITIVE_TYPE);
 */
 typedef QCPDataContainer<QCPGraphData> QCPGraphDataContainer;
 
+class QCP_LIB_DECL QCPColumnData
+{
+public:
+    class const_iterator
+    {
+    public:
+        // operator-> hands out a temporary, since the key and value of a point live in separate arrays:
+        class ArrowProxy
+        {
+        public:
+            explicit ArrowProxy(const QCPGraphData &data) : mData(data) {}
+            const QCPGraphData *operator->() const { return &mData; }
+        private:
+            QCPGraphData mData;
+        };
+
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef QCPGraphData value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef ArrowProxy pointer;
+        typedef QCPGraphData reference;
+
+        const_iterator() : mKey(nullptr), mValue(nullptr) {}
+        const_iterator(const double *key, const double *value) : mKey(key), mValue(value) {}
+
+        QCPGraphData operator*() const { return QCPGraphData(*mKey, *mValue); }
+        ArrowProxy operator->() const { return ArrowProxy(QCPGraphData(*mKey, *mValue)); }
+        QCPGraphData operator[](difference_type n) const { return QCPGraphData(mKey[n], mValue[n]); }
+
+        const_iterator &operator++() { ++mKey; ++mValue; return *this; }
+        const_iterator operator++(int) { const_iterator result(*this); ++*this; return result; }
+        const_iterator &operator--() { --mKey; --mValue; return *this; }
+        const_iterator operator--(int) { const_iterator result(*this); --*this; return result; }
+        const_iterator &operator+=(difference_type n) { mKey += n; mValue += n; return *this; }
+        const_iterator &operator-=(difference_type n) { mKey -= n; mValue -= n; return *this; }
+        const_iterator operator+(difference_type n) const { return const_iterator(mKey+n, mValue+n); }
+        const_iterator operator-(difference_type n) const { return const_iterator(mKey-n, mValue-n); }
+        difference_type operator-(const const_iterator &other) const { return mKey-other.mKey; }
+
+        bool operator==(const const_iterator &other) const { return mKey == other.mKey; }
+        bool operator!=(const const_iterator &other) const { return mKey != other.mKey; }
+        bool operator<(const const_iterator &other) const { return mKey < other.mKey; }
+        bool operator>(const const_iterator &other) const { return mKey > other.mKey; }
+        bool operator<=(const const_iterator &other) const { return mKey <= other.mKey; }
+        bool operator>=(const const_iterator &other) const { return mKey >= other.mKey; }
+
+    private:
+        const double *mKey;
+        const double *mValue;
+    };
+
+    QCPColumnData();
+    QCPColumnData(const double *keys, const double *values, int size);
+
+    // getters:
+    int size() const { return mSize; }
+    bool isEmpty() const { return mSize == 0; }
+    const double *keys() const { return mKeys; }
+    const double *values() const { return mValues; }
+    const_iterator constBegin() const { return const_iterator(mKeys, mValues); }
+    const_iterator constEnd() const { return const_iterator(mKeys+mSize, mValues+mSize); }
+    QCPGraphData at(int index) const { return QCPGraphData(mKeys[index], mValues[index]); }
+    QCPDataRange dataRange() const { return QCPDataRange(0, mSize); }
+
+    // non-property methods:
+    const_iterator findBegin(double sortKey, bool expandedRange=true) const;
+    const_iterator findEnd(double sortKey, bool expandedRange=true) const;
+    QCPRange keyRange(bool &foundRange, QCP::SignDomain signDomain=QCP::sdBoth) const;
+    QCPRange valueRange(bool &foundRange, QCP::SignDomain signDomain=QCP::sdBoth, const QCPRange &inKeyRange=QCPRange()) const;
+    void limitIteratorsToDataRange(const_iterator &begin, const_iterator &end, const QCPDataRange &dataRange) const;
+
+private:
+    const double *mKeys;
+    const double *mValues;
+    int mSize;
+};
+
+class QCP_LIB_DECL QCPMinMaxPyramid
+{
+public:
+    /*!
+      Summary of a run of consecutive data points: the first and last point plus the value extremes
+      in between.
+    */
+    struct Bucket
+    {
+        double firstKey, lastKey;
+        double firstValue, lastValue;
+        double minValue, maxValue;
+    };
+
+    QCPMinMaxPyramid();
+
+    // getters:
+    int size() const { return mSize; }
+    bool isEmpty() const { return mSize == 0; }
+    int levelCount() const { return mLevels.size(); }
+    const QVector<Bucket> &level(int index) const { return mLevels.at(index); }
+    int bucketSize(int level) const;
+
+    // non-property methods:
+    void clear();
+    void build(const double *keys, const double *values, int size);
+    void extend(const double *keys, const double *values, int size);
+
+    static const int baseBucketSize = 16; ///< data points summarized by a bucket of level 0
+    static const int fanout = 4; ///< buckets of one level summarized by a bucket of the next level
+
+private:
+    QVector<QVector<Bucket> > mLevels;
+    int mSize;
+
+    void update(const double *keys, const double *values, int firstChangedPoint);
+};
+
 class QCP_LIB_DECL QCPGraph : public QCPAbstractPlottable1D<QCPGraphData>
 {
     Q_OBJECT
@@ -5567,10 +5715,13 @@ protected:
     virtual void getOptimizedLineData(QVector<QCPGraphData> *lineData, const QCPGraphDataContainer::const_iterator &begin, const QCPGraphDataContainer::const_iterator &end) const;
     virtual void getOptimizedScatterData(QVector<QCPGraphData> *scatterData, QCPGraphDataContainer::const_iterator begin, QCPGraphDataContainer::const_iterator end) const;
 
+    virtual void getLines(QVector<QPointF> *lines, const QCPDataRange &dataRange) const;
+    virtual void getScatters(QVector<QPointF> *scatters, const QCPDataRange &dataRange) const;
+
     // non-virtual methods:
     void getVisibleDataBounds(QCPGraphDataContainer::const_iterator &begin, QCPGraphDataContainer::const_iterator &end, const QCPDataRange &rangeRestriction) const;
-    void getLines(QVector<QPointF> *lines, const QCPDataRange &dataRange) const;
-    void getScatters(QVector<QPointF> *scatters, const QCPDataRange &dataRange) const;
+    void lineDataToLines(QVector<QPointF> *lines, QVector<QCPGraphData> &lineData) const;
+    void scatterDataToPixels(QVector<QPointF> *scatters, QVector<QCPGraphData> &scatterData) const;
     QVector<QPointF> dataToLines(const QVector<QCPGraphData> &data) const;
     QVector<QPointF> dataToStepLeftLines(const QVector<QCPGraphData> &data) const;
     QVector<QPointF> dataToStepRightLines(const QVector<QCPGraphData> &data) const;
@@ -5588,11 +5739,63 @@ protected:
     int findIndexAboveY(const QVector<QPointF> *data, double y) const;
     double pointDistance(const QPointF &pixelPoint, QCPGraphDataContainer::const_iterator &closestData) const;
 
+    // algorithms shared with QCPColumnGraph, for any data source with QCPGraphData iterators (defined and instantiated in the cpp only):
+    template <class Iterator> void optimizedLineData(QVector<QCPGraphData> *lineData, Iterator begin, Iterator end) const;
+    template <class Iterator> void optimizedScatterData(QVector<QCPGraphData> *scatterData, Iterator dataBegin, Iterator begin, Iterator end) const;
+    template <class Container> double pointDistanceIn(const QPointF &pixelPoint, const Container &data, typename Container::const_iterator &closestData) const;
+
     friend class QCustomPlot;
     friend class QCPLegend;
 };
 Q_DECLARE_METATYPE(QCPGraph::LineStyle)
 
+class QCP_LIB_DECL QCPColumnGraph : public QCPGraph
+{
+    Q_OBJECT
+public:
+    explicit QCPColumnGraph(QCPAxis *keyAxis, QCPAxis *valueAxis);
+    virtual ~QCPColumnGraph() Q_DECL_OVERRIDE;
+
+    // getters:
+    QCPColumnData columns() const { return mColumns; }
+
+    // setters:
+    void setColumns(const double *keys, const double *values, int size);
+
+    // non-property methods:
+    void appendColumns(const double *keys, const double *values, int size);
+
+    // reimplemented virtual methods:
+    virtual int dataCount() const Q_DECL_OVERRIDE;
+    virtual double dataMainKey(int index) const Q_DECL_OVERRIDE;
+    virtual double dataSortKey(int index) const Q_DECL_OVERRIDE;
+    virtual double dataMainValue(int index) const Q_DECL_OVERRIDE;
+    virtual QCPRange dataValueRange(int index) const Q_DECL_OVERRIDE;
+    virtual QPointF dataPixelPosition(int index) const Q_DECL_OVERRIDE;
+    virtual QCPDataSelection selectTestRect(const QRectF &rect, bool onlySelectable) const Q_DECL_OVERRIDE;
+    virtual int findBegin(double sortKey, bool expandedRange=true) const Q_DECL_OVERRIDE;
+    virtual int findEnd(double sortKey, bool expandedRange=true) const Q_DECL_OVERRIDE;
+    virtual double selectTest(const QPointF &pos, bool onlySelectable, QVariant *details=nullptr) const Q_DECL_OVERRIDE;
+    virtual QCPRange getKeyRange(bool &foundRange, QCP::SignDomain inSignDomain=QCP::sdBoth) const Q_DECL_OVERRIDE;
+    virtual QCPRange getValueRange(bool &foundRange, QCP::SignDomain inSignDomain=QCP::sdBoth, const QCPRange &inKeyRange=QCPRange()) const Q_DECL_OVERRIDE;
+
+protected:
+    struct LineSampler; // defined in qcustomplot.cpp
+
+    // property members:
+    QCPColumnData mColumns;
+    QCPMinMaxPyramid mPyramid;
+
+    // reimplemented virtual methods:
+    virtual void getLines(QVector<QPointF> *lines, const QCPDataRange &dataRange) const Q_DECL_OVERRIDE;
+    virtual void getScatters(QVector<QPointF> *scatters, const QCPDataRange &dataRange) const Q_DECL_OVERRIDE;
+
+    // non-virtual methods:
+    void getVisibleDataBounds(QCPColumnData::const_iterator &begin, QCPColumnData::const_iterator &end, const QCPDataRange &rangeRestriction) const;
+    bool getPyramidLineData(QVector<QCPGraphData> *lineData, int begin, int end) const;
+    void samplePyramidRange(LineSampler &sampler, int level, int bucket, int begin, int end) const;
+};
+
 /* end of 'src/plottables/plottable-graph.h' */
 
 
@@ -0,0 +1,160 @@
+// speedPowerBaseline.cpp
+#include "speedPowerBaseline.h"
+#include <algorithm>  // Required for std::min, std::max, std::upper_bound
+#include <cmath>      // Required for std::log, std::exp, std::pow, std::floor, std::isnan
+#include <limits>     // Required for std::numeric_limits<double>::quiet_NaN()
+
+namespace {
+
+const double SecondsPerDay = 86400.0;
+
+} // namespace
+
+constexpr double SpeedPowerFit::MinSpeed;
+
+double SpeedPowerBaseline::expectedPower(double speed) const
+{
+    return coefficient * std::pow(speed, exponent);
+}
+
+double SpeedPowerBaseline::expectedSpeed(double power) const
+{
+    return std::pow(power / coefficient, 1.0 / exponent);
+}
+
+void SpeedPowerFit::add(const double* speed, const double* power, const double* steady, size_t count)
+{
+    // Sums of the batch first, then added to the totals: keeps the loop free of stores to members
+    double sumX = 0.0;
+    double sumY = 0.0;
+    double sumXX = 0.0;
+    double sumXY = 0.0;
+    size_t used = 0;
+    double minSpeed = mCount > 0 ? mMinSpeed : std::numeric_limits<double>::max();
+    double maxSpeed = mCount > 0 ? mMaxSpeed : 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        // Written so that NaN speed or power fails the test
+        if ((steady && steady[i] == 0.0) || !(speed[i] >= MinSpeed) || !(power[i] > 0.0)) {
+            continue;
+        }
+        const double x = std::log(speed[i]);
+        const double y = std::log(power[i]);
+        sumX += x;
+        sumY += y;
+        sumXX += x * x;
+        sumXY += x * y;
+        minSpeed = std::min(minSpeed, speed[i]);
+        maxSpeed = std::max(maxSpeed, speed[i]);
+        ++used;
+    }
+    if (used == 0) {
+        return;
+    }
+    mSumX += sumX;
+    mSumY += sumY;
+    mSumXX += sumXX;
+    mSumXY += sumXY;
+    mCount += used;
+    mMinSpeed = minSpeed;
+    mMaxSpeed = maxSpeed;
+}
+
+void SpeedPowerFit::merge(const SpeedPowerFit& other)
+{
+    if (other.mCount == 0) {
+        return;
+    }
+    mMinSpeed = mCount > 0 ? std::min(mMinSpeed, other.mMinSpeed) : other.mMinSpeed;
+    mMaxSpeed = mCount > 0 ? std::max(mMaxSpeed, other.mMaxSpeed) : other.mMaxSpeed;
+    mSumX += other.mSumX;
+    mSumY += other.mSumY;
+    mSumXX += other.mSumXX;
+    mSumXY += other.mSumXY;
+    mCount += other.mCount;
+}
+
+SpeedPowerBaseline SpeedPowerFit::baseline() const
+{
+    SpeedPowerBaseline baseline;
+    const double n = static_cast<double>(mCount);
+    const double denominator = n * mSumXX - mSumX * mSumX;
+    if (mCount < 2 || !(denominator > 1e-12 * n * n)) {
+        return baseline; // Too few samples, or all at the same speed: no curve to fit
+    }
+    baseline.exponent = (n * mSumXY - mSumX * mSumY) / denominator;
+    baseline.coefficient = std::exp((mSumY - baseline.exponent * mSumX) / n);
+    baseline.minSpeed = mMinSpeed;
+    baseline.maxSpeed = mMaxSpeed;
+    baseline.sampleCount = mCount;
+    return baseline;
+}
+
+SpeedPowerBaseline fitReferenceBaseline(const double* time, const double* speed, const double* power,
+    const double* steady, size_t count, double referenceSeconds)
+{
+    // A single bad timestamp would otherwise anchor the reference period in January 1970
+    const size_t firstValid = std::upper_bound(time, time + count, 0.0) - time;
+    if (firstValid == count) {
+        return SpeedPowerBaseline();
+    }
+    const size_t referenceEnd = std::upper_bound(time + firstValid, time + count, time[firstValid] + referenceSeconds) - time;
+    SpeedPowerFit fit;
+    fit.add(speed + firstValid, power + firstValid, steady ? steady + firstValid : nullptr, referenceEnd - firstValid);
+    return fit.baseline();
+}
+
+void computeSpeedLoss(const SpeedPowerBaseline& baseline, const double* speed, const double* power,
+    const double* steady, size_t count, double* speedLoss)
+{
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    if (!baseline.valid()) {
+        std::fill(speedLoss, speedLoss + count, nan);
+        return;
+    }
+    // Vexpected = (P / a)^(1/n) = exp((log P - log a) / n)
+    const double logCoefficient = std::log(baseline.coefficient);
+    const double inverseExponent = 1.0 / baseline.exponent;
+    for (size_t i = 0; i < count; ++i) {
+        const bool usable = (!steady || steady[i] != 0.0) && speed[i] >= baseline.minSpeed
+            && speed[i] <= baseline.maxSpeed && power[i] > 0.0;
+        if (!usable) {
+            speedLoss[i] = nan;
+            continue;
+        }
+        const double expected = std::exp((std::log(power[i]) - logCoefficient) * inverseExponent);
+        speedLoss[i] = 100.0 * (expected - speed[i]) / expected;
+    }
+}
+
+void DailyTrend::add(const double* time, const double* values, size_t count)
+{
+    for (size_t i = 0; i < count; ++i) {
+        if (std::isnan(values[i]) || !(time[i] > 0.0)) {
+            continue;
+        }
+        const double dayStart = std::floor(time[i] / SecondsPerDay) * SecondsPerDay;
+        if (mDayStarts.empty() || dayStart > mDayStarts.back()) {
+            mDayStarts.push_back(dayStart);
+            mSums.push_back(0.0);
+            mCounts.push_back(0);
+        }
+        mSums.back() += values[i];
+        ++mCounts.back();
+    }
+}
+
+void DailyTrend::clear()
+{
+    mDayStarts.clear();
+    mSums.clear();
+    mCounts.clear();
+}
+
+std::vector<double> DailyTrend::means() const
+{
+    std::vector<double> means(mSums.size());
+    for (size_t day = 0; day < means.size(); ++day) {
+        means[day] = mSums[day] / static_cast<double>(mCounts[day]);
+    }
+    return means;
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+// speedPowerBaseline.h
+#ifndef SPEED_POWER_BASELINE_H
+#define SPEED_POWER_BASELINE_H
+
+#include <cstddef>
+#include <vector>
+
+// Reference speed-power curve P = coefficient * V^exponent (STW in kn, shaft power in kW), as
+// fitted over a reference period in which the hull and propeller are taken as clean.
+struct SpeedPowerBaseline
+{
+    double coefficient = 0.0;
+    double exponent = 0.0;
+    double minSpeed = 0.0; // Speed range of the reference samples; the curve is not used outside it
+    double maxSpeed = 0.0;
+    size_t sampleCount = 0;
+
+    bool valid() const { return sampleCount >= 2 && coefficient > 0.0 && exponent > 0.0; }
+    double expectedPower(double speed) const;
+    double expectedSpeed(double power) const;
+};
+
+// Least-squares fit of log(power) against log(speed), accumulated batch by batch: every sample
+// only adds to four running sums and a count, so the fit is one linear pass over any amount of
+// data and partial fits (e.g. per thread or per block) can be merged.
+class SpeedPowerFit
+{
+public:
+    // Adds the steady rows (steady[i] != 0; steady may be null for all rows) with a speed of at
+    // least MinSpeed and positive power; the others are left out.
+    void add(const double* speed, const double* power, const double* steady, size_t count);
+    void merge(const SpeedPowerFit& other);
+
+    SpeedPowerBaseline baseline() const;
+
+    // Below this STW (kn) the ship is manoeuvring or drifting and the curve doesn't apply
+    static constexpr double MinSpeed = 3.0;
+
+private:
+    double mSumX = 0.0;  // log speed
+    double mSumY = 0.0;  // log power
+    double mSumXX = 0.0;
+    double mSumXY = 0.0;
+    size_t mCount = 0;
+    double mMinSpeed = 0.0;
+    double mMaxSpeed = 0.0;
+};
+
+// Fits the baseline over the rows logged within referenceSeconds of the first one with a valid
+// timestamp (time in seconds, ascending). Time 0 marks a missing or malformed timestamp (see
+// TypedColumn::epochs); such rows sort to the front and are left out.
+SpeedPowerBaseline fitReferenceBaseline(const double* time, const double* speed, const double* power,
+    const double* steady, size_t count, double referenceSeconds);
+
+// Speed loss of every row in percent, the ISO 19030 performance value: how much slower the ship
+// sails than the baseline at the same power, (Vexpected - V) / Vexpected. NaN for rows that are
+// not steady or outside the baseline's speed range. One pass, written straight into speedLoss.
+void computeSpeedLoss(const SpeedPowerBaseline& baseline, const double* speed, const double* power,
+    const double* steady, size_t count, double* speedLoss);
+
+// Daily means of a channel (NaN values left out), built incrementally from rows in time order.
+class DailyTrend
+{
+public:
+    // Adds rows following the ones added before (time in seconds since epoch, UTC days). Rows with
+    // time 0, i.e. without a valid timestamp, are left out.
+    void add(const double* time, const double* values, size_t count);
+    void clear();
+
+    const std::vector<double>& dayStarts() const { return mDayStarts; } // Midnight of every day with data
+    std::vector<double> means() const;
+
+private:
+    std::vector<double> mDayStarts;
+    std::vector<double> mSums;
+    std::vector<size_t> mCounts;
+};
+
+#endif // SPEED_POWER_BASELINE_H
\ No newline at end of file
@@ -0,0 +1,95 @@
+// steadyState.cpp
+#include "steadyState.h"
+#include <algorithm>  // Required for std::max
+#include <cmath>      // Required for std::isnan
+
+RollingStats::RollingStats(size_t window)
+    : mValues(std::max<size_t>(window, 1))
+{
+}
+
+void RollingStats::push(double value)
+{
+    const size_t window = mValues.size();
+    if (mCount < window) {
+        // Filling up: plain Welford update
+        ++mCount;
+        const double delta = value - mMean;
+        mMean += delta / static_cast<double>(mCount);
+        mM2 += delta * (value - mMean);
+    }
+    else {
+        // Full: the oldest value leaves as the new one enters, in a single update
+        const double oldest = mValues[mNext];
+        const double oldMean = mMean;
+        mMean += (value - oldest) / static_cast<double>(window);
+        mM2 += (value - oldest) * (value - mMean + oldest - oldMean);
+    }
+    mValues[mNext] = value;
+    mNext = (mNext + 1) % window;
+}
+
+void RollingStats::clear()
+{
+    mNext = 0;
+    mCount = 0;
+    mMean = 0.0;
+    mM2 = 0.0;
+}
+
+double RollingStats::variance() const
+{
+    // Rounding can leave a tiny negative sum after many updates of a constant signal
+    return mCount == 0 ? 0.0 : std::max(mM2, 0.0) / static_cast<double>(mCount);
+}
+
+SteadyStateDetector::SteadyStateDetector(const SteadyStateLimits& limits)
+    : mLimits(limits),
+    mPropRev(limits.window),
+    mPropPower(limits.window),
+    mStw(limits.window)
+{
+}
+
+bool SteadyStateDetector::add(double propRev, double propPower, double stw)
+{
+    return addRow(true, propRev, propPower, stw);
+}
+
+void SteadyStateDetector::flag(const double* propRev, const double* propPower, const double* stw, size_t count, double* steady)
+{
+    const bool withPropRev = propRev != nullptr;
+    for (size_t i = 0; i < count; ++i) {
+        steady[i] = addRow(withPropRev, withPropRev ? propRev[i] : 0.0, propPower[i], stw[i]) ? 1.0 : 0.0;
+    }
+}
+
+void SteadyStateDetector::reset()
+{
+    mPropRev.clear();
+    mPropPower.clear();
+    mStw.clear();
+}
+
+bool SteadyStateDetector::addRow(bool withPropRev, double propRev, double propPower, double stw)
+{
+    if (std::isnan(propRev) || std::isnan(propPower) || std::isnan(stw)) {
+        reset();
+        return false;
+    }
+    if (withPropRev) {
+        mPropRev.push(propRev);
+    }
+    mPropPower.push(propPower);
+    mStw.push(stw);
+    if (!mPropPower.full()) {
+        return false;
+    }
+
+    // Compared as variances, so no square root per row
+    const double maxPower = mLimits.maxPowerVariation * mPropPower.mean();
+    return mPropPower.mean() > 0.0
+        && mPropPower.variance() <= maxPower * maxPower
+        && mStw.variance() <= mLimits.maxStwStdDev * mLimits.maxStwStdDev
+        && (!withPropRev || mPropRev.variance() <= mLimits.maxPropRevStdDev * mLimits.maxPropRevStdDev);
+}
\ No newline at end of file
@@ -0,0 +1,70 @@
+// steadyState.h
+#ifndef STEADY_STATE_H
+#define STEADY_STATE_H
+
+#include <cstddef>
+#include <vector>
+
+// Mean and variance of the last `window` values pushed. Each push updates them in O(1) (sliding
+// Welford update), so a whole log is processed in one pass without revisiting any window.
+class RollingStats
+{
+public:
+    explicit RollingStats(size_t window);
+
+    void push(double value);
+    void clear();
+
+    bool full() const { return mCount == mValues.size(); }
+    double mean() const { return mMean; }
+    double variance() const; // Population variance of the values in the window
+
+private:
+    std::vector<double> mValues; // Ring buffer holding the window
+    size_t mNext = 0;
+    size_t mCount = 0;
+    double mMean = 0.0;
+    double mM2 = 0.0;            // Sum of squared deviations from the mean
+};
+
+// When a window of rows counts as steady. The defaults follow the ISO 19030 validation limits for
+// 10-minute blocks (1-minute logger samples): shaft speed within 3 rpm and STW within 0.5 kn
+// (standard deviation), plus shaft power within 5% of its mean.
+struct SteadyStateLimits
+{
+    size_t window = 10;               // Rows
+    double maxPropRevStdDev = 3.0;    // rpm
+    double maxStwStdDev = 0.5;        // kn
+    double maxPowerVariation = 0.05;  // Standard deviation over mean
+};
+
+// Streaming steady-state detector: separates the rows logged at steady running from manoeuvring,
+// acceleration and load changes, so SFOC and speed-power relations are judged on valid samples
+// only. A row is steady when the window of rows ending with it stays within the limits for
+// propeller speed, shaft power and STW, with the engine delivering power. Rows are fed in log
+// order; the detector keeps its windows between calls, so a log can be flagged block by block.
+class SteadyStateDetector
+{
+public:
+    explicit SteadyStateDetector(const SteadyStateLimits& limits = SteadyStateLimits());
+
+    // Adds the next row and returns whether it is steady. A missing value (NaN) restarts the
+    // windows, so the rows after a gap are transient until a full window has been seen again.
+    bool add(double propRev, double propPower, double stw);
+
+    // Flags count rows at once: steady[i] becomes 1.0 for steady rows and 0.0 for transient ones.
+    // propRev may be null for loggers without shaft speed; it is then left out of the criteria.
+    void flag(const double* propRev, const double* propPower, const double* stw, size_t count, double* steady);
+
+    void reset();
+
+private:
+    SteadyStateLimits mLimits;
+    RollingStats mPropRev;
+    RollingStats mPropPower;
+    RollingStats mStw;
+
+    bool addRow(bool withPropRev, double propRev, double propPower, double stw);
+};
+
+#endif // STEADY_STATE_H
\ No newline at end of file
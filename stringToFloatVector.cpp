@@ -1,19 +1,117 @@
+#include "stringToFloatVector.h"
 #include <iostream>
 #include <vector>
 #include <string>
 #include <algorithm> // Required for std::transform
+#include <charconv>  // Required for std::from_chars
+#include <cstdint>   // Required for std::uint64_t
+#include <limits>    // Required for std::numeric_limits<double>::quiet_NaN()
 
+namespace {
 
-std::vector<float> convertStringVectorToFloatVector(const std::vector<std::string>& stringVec)
+// Exactly representable powers of ten, for the fast path below
+const double kPowersOfTen[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+// Strips surrounding blanks and a leading '+', which std::from_chars does not accept
+std::string_view trimNumber(std::string_view text)
+{
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t')) {
+        text.remove_suffix(1);
+    }
+    if (text.size() > 1 && text.front() == '+' && text[1] != '-') {
+        text.remove_prefix(1);
+    }
+    return text;
+}
+
+// Plain fixed-point numbers ("-12.345") with at most 15 significant digits are exact as an
+// integer mantissa, and dividing by an exact power of ten then rounds correctly (Clinger's fast
+// path). That covers virtually every logger value; anything else is left to std::from_chars.
+bool parseFixedPoint(std::string_view text, double& value)
+{
+    const char* pos = text.data();
+    const char* const end = text.data() + text.size();
+
+    const bool negative = (pos != end && *pos == '-');
+    if (negative) {
+        ++pos;
+    }
+
+    std::uint64_t mantissa = 0;
+    int digits = 0;
+    int fraction_digits = 0;
+    for (; pos != end && *pos >= '0' && *pos <= '9'; ++pos, ++digits) {
+        mantissa = mantissa * 10 + static_cast<std::uint64_t>(*pos - '0');
+    }
+    if (pos != end && *pos == '.') {
+        for (++pos; pos != end && *pos >= '0' && *pos <= '9'; ++pos, ++digits, ++fraction_digits) {
+            mantissa = mantissa * 10 + static_cast<std::uint64_t>(*pos - '0');
+        }
+    }
+
+    if (pos != end || digits == 0 || digits > 15) {
+        return false; // Exponent, junk, or too many digits for the exact path
+    }
+    value = static_cast<double>(mantissa) / kPowersOfTen[fraction_digits];
+    if (negative) {
+        value = -value;
+    }
+    return true;
+}
+
+} // namespace
+
+bool parseDouble(std::string_view text, double& value)
+{
+    text = trimNumber(text);
+    if (parseFixedPoint(text, value)) {
+        return true;
+    }
+
+    const char* last = text.data() + text.size();
+    auto result = std::from_chars(text.data(), last, value);
+    return result.ec == std::errc() && result.ptr == last && !text.empty();
+}
+
+size_t convertStringViewsToDoubles(const std::vector<std::string_view>& cells, double* out)
 {
-    std::vector<float> floatVec;
-    floatVec.reserve(stringVec.size()); // Pre-allocate memory to avoid reallocations
-
-    // Use std::transform to apply std::stof to each element
-    std::transform(stringVec.begin(), stringVec.end(),
-        std::back_inserter(floatVec),
-        [](const std::string& str) {
-            return std::stof(str); // Direct conversion, no error checks
+    size_t errors = 0;
+    for (size_t i = 0; i < cells.size(); ++i) {
+        if (!parseDouble(cells[i], out[i])) {
+            out[i] = std::numeric_limits<double>::quiet_NaN(); // Mark the bad cell, keep going
+            ++errors;
+        }
+    }
+    return errors;
+}
+
+std::vector<float> convertStringVectorToFloatVector(const std::vector<std::string>& stringVec, size_t* errorCount)
+{
+    std::vector<float> floatVec(stringVec.size()); // Preallocated, written in place
+    size_t errors = 0;
+
+    // Use std::transform to apply std::from_chars to each element
+    std::transform(stringVec.begin(), stringVec.end(), floatVec.begin(),
+        [&errors](const std::string& str) {
+            std::string_view text = trimNumber(str);
+            const char* last = text.data() + text.size();
+            float value = 0.0f;
+            auto result = std::from_chars(text.data(), last, value);
+            if (result.ec != std::errc() || result.ptr != last || text.empty()) {
+                ++errors;
+                return std::numeric_limits<float>::quiet_NaN(); // Mark the bad cell, keep going
+            }
+            return value;
         });
+
+    if (errorCount != nullptr) {
+        *errorCount = errors;
+    }
     return floatVec;
 }
\ No newline at end of file
@@ -5,7 +5,20 @@
 
 #include <vector>
 #include <string>
+#include <string_view>
+#include <cstddef>
 
-std::vector<float> convertStringVectorToFloatVector(const std::vector<std::string>& stringVec);
+// Parses a decimal number such as "4672.0", "-1.5e3" or " +7 " without consulting the locale
+// and without throwing. Surrounding blanks and a leading '+' are accepted; anything else that
+// is not part of the number makes the parse fail.
+bool parseDouble(std::string_view text, double& value);
 
-#endif // !STRING_TO_FLOAT_VECTOR
+// Converts every cell into out[i] (out must have room for cells.size() values). Cells that are
+// not numbers become NaN; the return value is how many there were.
+size_t convertStringViewsToDoubles(const std::vector<std::string_view>& cells, double* out);
+
+// Converts strings to floats; cells that are not numbers become NaN instead of aborting the
+// conversion. If errorCount is given it receives the number of such cells.
+std::vector<float> convertStringVectorToFloatVector(const std::vector<std::string>& stringVec, size_t* errorCount = nullptr);
+
+#endif // !STRING_TO_FLOAT_VECTOR
\ No newline at end of file
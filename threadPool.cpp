@@ -0,0 +1,53 @@
+// threadPool.cpp
+
+#include "threadPool.h"
+
+ThreadPool::ThreadPool(size_t threadCount)
+{
+    if (threadCount == 0) {
+        threadCount = std::thread::hardware_concurrency();
+    }
+    if (threadCount == 0) {
+        threadCount = 1; // hardware_concurrency() may be unknown
+    }
+
+    mWorkers.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        mWorkers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopping = true;
+    }
+    mWakeUp.notify_all();
+    for (std::thread& worker : mWorkers) {
+        worker.join(); // Workers drain the queue before they exit
+    }
+}
+
+ThreadPool& ThreadPool::shared()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+void ThreadPool::workerLoop()
+{
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mWakeUp.wait(lock, [this]() { return mStopping || !mTasks.empty(); });
+            if (mTasks.empty()) {
+                return; // Stopping and nothing left to do
+            }
+            task = std::move(mTasks.front());
+            mTasks.pop();
+        }
+        task();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+// threadPool.h
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <type_traits>
+
+// Fixed-size pool of worker threads executing submitted tasks in FIFO order.
+// Tasks must not block waiting on other tasks of the same pool, or the pool can deadlock.
+class ThreadPool
+{
+public:
+    explicit ThreadPool(size_t threadCount = 0); // 0 uses one thread per hardware core
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t threadCount() const { return mWorkers.size(); }
+
+    // Queues a task and returns a future for its result (exceptions are rethrown by get()).
+    template <class Function>
+    std::future<std::invoke_result_t<Function>> submit(Function&& task)
+    {
+        using Result = std::invoke_result_t<Function>;
+        auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<Function>(task));
+        std::future<Result> result = packaged->get_future();
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mTasks.emplace([packaged]() { (*packaged)(); });
+        }
+        mWakeUp.notify_one();
+        return result;
+    }
+
+    // Process-wide pool sized to the machine, shared by the parsers.
+    static ThreadPool& shared();
+
+private:
+    void workerLoop();
+
+    std::vector<std::thread> mWorkers;
+    std::queue<std::function<void()>> mTasks;
+    std::mutex mMutex;
+    std::condition_variable mWakeUp;
+    bool mStopping = false;
+};
+
+#endif // THREAD_POOL_H
\ No newline at end of file
@@ -0,0 +1,165 @@
+// timeIndex.cpp
+#include "timeIndex.h"
+#include <algorithm>  // Required for std::min, std::max, std::lower_bound, std::upper_bound
+#include <cmath>      // Required for std::isnan
+#include <limits>     // Required for std::numeric_limits<double>::quiet_NaN()
+
+const size_t BlockSummary::BlockRows;
+
+IntervalStats::IntervalStats()
+    : mean(std::numeric_limits<double>::quiet_NaN()),
+    min(std::numeric_limits<double>::quiet_NaN()),
+    max(std::numeric_limits<double>::quiet_NaN())
+{
+}
+
+void BlockSummary::update(const double* values, size_t count, size_t firstRow)
+{
+    // The block holding firstRow is summarised again from its start
+    const size_t firstBlock = std::min(firstRow / BlockRows, mBlocks.size());
+    if (firstBlock < mBlocks.size()) {
+        mTotalSum = mSumBefore[firstBlock];
+        mBlocks.resize(firstBlock);
+        mSumBefore.resize(firstBlock);
+    }
+
+    for (size_t start = firstBlock * BlockRows; start < count; start += BlockRows) {
+        const size_t end = std::min(start + BlockRows, count);
+        Block block = { 0, std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN() };
+        double sum = 0.0;
+        for (size_t i = start; i < end; ++i) {
+            const double value = values[i];
+            if (std::isnan(value)) {
+                continue;
+            }
+            block.min = block.count == 0 ? value : std::min(block.min, value);
+            block.max = block.count == 0 ? value : std::max(block.max, value);
+            sum += value;
+            ++block.count;
+        }
+        mBlocks.push_back(block);
+        mSumBefore.push_back(mTotalSum);
+        mTotalSum += sum;
+    }
+}
+
+void BlockSummary::clear()
+{
+    mBlocks.clear();
+    mSumBefore.clear();
+    mTotalSum = 0.0;
+}
+
+IntervalStats BlockSummary::stats(const double* values, RowRange rows) const
+{
+    IntervalStats stats;
+    rows.last = std::min(rows.last, mBlocks.size() * BlockRows);
+    if (rows.empty()) {
+        return stats;
+    }
+
+    // Whole blocks lie between the partial ones at either end
+    const size_t firstWhole = (rows.first + BlockRows - 1) / BlockRows;
+    const size_t endWhole = rows.last / BlockRows;
+    double sum = 0.0;
+    if (firstWhole >= endWhole) {
+        addPartial(values, rows.first, rows.last, stats, sum);
+    } else {
+        addPartial(values, rows.first, firstWhole * BlockRows, stats, sum);
+        addPartial(values, endWhole * BlockRows, rows.last, stats, sum);
+
+        const double sumAfter = endWhole < mBlocks.size() ? mSumBefore[endWhole] : mTotalSum;
+        sum += sumAfter - mSumBefore[firstWhole];
+        for (size_t block = firstWhole; block < endWhole; ++block) {
+            const Block& summary = mBlocks[block];
+            if (summary.count == 0) {
+                continue;
+            }
+            stats.min = stats.count == 0 ? summary.min : std::min(stats.min, summary.min);
+            stats.max = stats.count == 0 ? summary.max : std::max(stats.max, summary.max);
+            stats.count += summary.count;
+        }
+    }
+    if (stats.count > 0) {
+        stats.mean = sum / static_cast<double>(stats.count);
+    }
+    return stats;
+}
+
+void BlockSummary::addPartial(const double* values, size_t first, size_t last, IntervalStats& stats, double& sum) const
+{
+    for (size_t i = first; i < last; ++i) {
+        const double value = values[i];
+        if (std::isnan(value)) {
+            continue;
+        }
+        stats.min = stats.count == 0 ? value : std::min(stats.min, value);
+        stats.max = stats.count == 0 ? value : std::max(stats.max, value);
+        sum += value;
+        ++stats.count;
+    }
+}
+
+TimeIndex::TimeIndex(double maxGapSeconds)
+    : mMaxGapSeconds(maxGapSeconds)
+{
+}
+
+void TimeIndex::update(const double* time, size_t count, size_t firstRow)
+{
+    // A gap ending at firstRow or later may have changed
+    const size_t keptGaps = std::lower_bound(mGapRows.begin(), mGapRows.end(), firstRow) - mGapRows.begin();
+    mGapRows.resize(keptGaps);
+    mGapSecondsBefore.resize(keptGaps);
+
+    double total = mGapSecondsBefore.empty() ? 0.0 : mGapSecondsBefore.back();
+    for (size_t i = std::max<size_t>(firstRow, 1); i < count; ++i) {
+        const double step = time[i] - time[i - 1];
+        if (step > mMaxGapSeconds) {
+            total += step;
+            mGapRows.push_back(i);
+            mGapSecondsBefore.push_back(total);
+        }
+    }
+}
+
+void TimeIndex::clear()
+{
+    mGapRows.clear();
+    mGapSecondsBefore.clear();
+}
+
+RowRange TimeIndex::rowsBetween(const double* time, size_t count, double fromTime, double toTime)
+{
+    RowRange rows;
+    rows.first = std::lower_bound(time, time + count, fromTime) - time;
+    rows.last = std::max(rows.first, static_cast<size_t>(std::upper_bound(time, time + count, toTime) - time));
+    return rows;
+}
+
+size_t TimeIndex::gapsUpTo(size_t row) const
+{
+    return std::upper_bound(mGapRows.begin(), mGapRows.end(), row) - mGapRows.begin();
+}
+
+size_t TimeIndex::gapCount(RowRange rows) const
+{
+    if (rows.size() < 2) {
+        return 0;
+    }
+    // Gaps ending at rows first+1 .. last-1
+    return gapsUpTo(rows.last - 1) - gapsUpTo(rows.first);
+}
+
+double TimeIndex::gapSeconds(RowRange rows) const
+{
+    if (rows.size() < 2) {
+        return 0.0;
+    }
+    const size_t before = gapsUpTo(rows.first);
+    const size_t upTo = gapsUpTo(rows.last - 1);
+    if (upTo == before) {
+        return 0.0;
+    }
+    return mGapSecondsBefore[upTo - 1] - (before > 0 ? mGapSecondsBefore[before - 1] : 0.0);
+}
\ No newline at end of file
@@ -0,0 +1,87 @@
+// timeIndex.h
+#ifndef TIME_INDEX_H
+#define TIME_INDEX_H
+
+#include <cstddef>
+#include <vector>
+
+// Rows [first, last) of a dataset.
+struct RowRange
+{
+    size_t first = 0;
+    size_t last = 0;
+
+    size_t size() const { return last - first; }
+    bool empty() const { return last <= first; }
+};
+
+// Summary of one channel over a range of rows; NaN values are left out. mean, min and max are NaN
+// when no value was counted.
+struct IntervalStats
+{
+    size_t count = 0;
+    double mean;
+    double min;
+    double max;
+
+    IntervalStats();
+};
+
+// Per-block sum, count, minimum and maximum of one channel, with running totals over the blocks.
+// A range then costs at most two partial blocks plus one step per whole block (the sum of the
+// whole blocks comes from the running totals) instead of a pass over every row in it.
+class BlockSummary
+{
+public:
+    static const size_t BlockRows = 1024;
+
+    // Re-summarises the rows from firstRow on (the rows before it must be unchanged since the last
+    // update); count is the channel's new row count.
+    void update(const double* values, size_t count, size_t firstRow = 0);
+    void clear();
+
+    IntervalStats stats(const double* values, RowRange rows) const;
+
+private:
+    struct Block
+    {
+        size_t count;
+        double min;
+        double max;
+    };
+    std::vector<Block> mBlocks;
+    std::vector<double> mSumBefore; // Per block: sum of the values in all blocks before it
+    double mTotalSum = 0.0;
+
+    void addPartial(const double* values, size_t first, size_t last, IntervalStats& stats, double& sum) const;
+};
+
+// Index over an ascending time column (seconds): finds the rows of a time window by binary search
+// and records where the logger went silent for longer than maxGapSeconds, so the number and total
+// length of the gaps in any window are known in O(log n) as well.
+class TimeIndex
+{
+public:
+    explicit TimeIndex(double maxGapSeconds = 600.0);
+
+    // Re-indexes the rows from firstRow on (the rows before it must be unchanged since the last
+    // update); count is the column's new row count.
+    void update(const double* time, size_t count, size_t firstRow = 0);
+    void clear();
+
+    // Rows with fromTime <= time <= toTime.
+    static RowRange rowsBetween(const double* time, size_t count, double fromTime, double toTime);
+
+    size_t gapCount(RowRange rows) const;   // Gaps between rows of the range
+    double gapSeconds(RowRange rows) const; // Their total length
+    double maxGapSeconds() const { return mMaxGapSeconds; }
+
+private:
+    double mMaxGapSeconds;
+    std::vector<size_t> mGapRows;          // First row after every gap, ascending
+    std::vector<double> mGapSecondsBefore; // Per gap: total length of the gaps up to and including it
+
+    size_t gapsUpTo(size_t row) const; // Gaps that end at or before row
+};
+
+#endif // TIME_INDEX_H
\ No newline at end of file
@@ -0,0 +1,179 @@
+// timestampParser.cpp
+
+#include "timestampParser.h"
+#include <cstring>   // Required for std::memcmp, std::memcpy
+
+namespace {
+
+// Reads exactly `count` decimal digits starting at text[pos]
+bool readDigits(std::string_view text, size_t pos, size_t count, int& value)
+{
+    value = 0;
+    for (size_t i = pos; i < pos + count; ++i) {
+        if (text[i] < '0' || text[i] > '9') {
+            return false;
+        }
+        value = value * 10 + (text[i] - '0');
+    }
+    return true;
+}
+
+// Days since 1970-01-01 for a proleptic Gregorian date (H. Hinnant's days_from_civil)
+std::int64_t daysFromCivil(int year, int month, int day)
+{
+    year -= month <= 2;
+    const std::int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const int yearOfEra = year - static_cast<int>(era * 400);
+    const int dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    const int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+bool isValidDate(int year, int month, int day)
+{
+    static const int daysInMonth[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    if (month < 1 || month > 12 || day < 1) {
+        return false;
+    }
+    const bool leapYear = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    return day <= daysInMonth[month - 1] + (month == 2 && leapYear ? 1 : 0);
+}
+
+// Decodes "HH:mm" or "HH:mm:ss" at the start of text; `consumed` receives its length
+bool parseTimeOfDay(std::string_view text, bool withSeconds, bool secondsOptional, int& seconds, size_t& consumed)
+{
+    int hour, minute, second = 0;
+    if (text.size() < 5 || text[2] != ':' || !readDigits(text, 0, 2, hour) || !readDigits(text, 3, 2, minute)) {
+        return false;
+    }
+    consumed = 5;
+    if (withSeconds || (secondsOptional && text.size() >= 8 && text[5] == ':')) {
+        if (text.size() < 8 || text[5] != ':' || !readDigits(text, 6, 2, second)) {
+            return false;
+        }
+        consumed = 8;
+    }
+    if (hour > 23 || minute > 59 || second > 60) { // 60 allows a leap second
+        return false;
+    }
+    seconds = hour * 3600 + minute * 60 + second;
+    return true;
+}
+
+std::string_view trimBlanks(std::string_view text)
+{
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t')) {
+        text.remove_suffix(1);
+    }
+    return text;
+}
+
+} // namespace
+
+TimestampParser::TimestampParser(TimestampFormat format)
+    : mFormat(format)
+{
+}
+
+bool TimestampParser::parseDate(std::string_view date, std::int64_t& day)
+{
+    // Same date as the previous row: reuse its day number
+    if (mHasCachedDate && std::memcmp(date.data(), mCachedDate, sizeof(mCachedDate)) == 0) {
+        day = mCachedDay;
+        return true;
+    }
+
+    int year, month, dayOfMonth;
+    if (mFormat == TimestampFormat::Iso8601) {
+        if (date[4] != '-' || date[7] != '-' || !readDigits(date, 0, 4, year) ||
+            !readDigits(date, 5, 2, month) || !readDigits(date, 8, 2, dayOfMonth)) {
+            return false;
+        }
+    }
+    else {
+        if (date[2] != '/' || date[5] != '/' || !readDigits(date, 0, 2, dayOfMonth) ||
+            !readDigits(date, 3, 2, month) || !readDigits(date, 6, 4, year)) {
+            return false;
+        }
+    }
+    if (!isValidDate(year, month, dayOfMonth)) {
+        return false;
+    }
+
+    day = daysFromCivil(year, month, dayOfMonth);
+    std::memcpy(mCachedDate, date.data(), sizeof(mCachedDate));
+    mCachedDay = day;
+    mHasCachedDate = true;
+    return true;
+}
+
+bool TimestampParser::parse(std::string_view text, std::int64_t& epoch)
+{
+    text = trimBlanks(text);
+
+    // Both layouts start with a 10 character date followed by a separator
+    if (text.size() < 16) {
+        return false;
+    }
+    const char separator = text[10];
+    if (!(separator == ' ' || (mFormat == TimestampFormat::Iso8601 && separator == 'T'))) {
+        return false;
+    }
+
+    std::int64_t day;
+    if (!parseDate(text.substr(0, 10), day)) {
+        return false;
+    }
+
+    int seconds;
+    size_t consumed;
+    std::string_view rest = text.substr(11);
+    if (!parseTimeOfDay(rest, mFormat == TimestampFormat::DayMonthYearSeconds, mFormat == TimestampFormat::Iso8601, seconds, consumed)) {
+        return false;
+    }
+    rest.remove_prefix(consumed);
+
+    int offset = 0; // Seconds east of UTC
+    if (mFormat == TimestampFormat::Iso8601) {
+        // Fractional seconds are dropped, the plots work in whole seconds
+        if (!rest.empty() && (rest.front() == '.' || rest.front() == ',')) {
+            rest.remove_prefix(1);
+            size_t digits = 0;
+            while (digits < rest.size() && rest[digits] >= '0' && rest[digits] <= '9') {
+                ++digits;
+            }
+            if (digits == 0) {
+                return false;
+            }
+            rest.remove_prefix(digits);
+        }
+
+        if (rest == "Z") {
+            rest = {};
+        }
+        else if (!rest.empty() && (rest.front() == '+' || rest.front() == '-')) {
+            int offsetHours, offsetMinutes = 0;
+            const bool colon = rest.size() == 6 && rest[3] == ':';
+            if (!((rest.size() == 3 || rest.size() == 5 || colon) && readDigits(rest, 1, 2, offsetHours))) {
+                return false;
+            }
+            if (rest.size() > 3 && !readDigits(rest, colon ? 4 : 3, 2, offsetMinutes)) {
+                return false;
+            }
+            if (offsetHours > 23 || offsetMinutes > 59) {
+                return false;
+            }
+            offset = (offsetHours * 3600 + offsetMinutes * 60) * (rest.front() == '-' ? -1 : 1);
+            rest = {};
+        }
+    }
+    if (!rest.empty()) {
+        return false; // Trailing characters
+    }
+
+    epoch = day * 86400 + seconds - offset;
+    return true;
+}
\ No newline at end of file
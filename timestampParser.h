@@ -0,0 +1,40 @@
+// timestampParser.h
+#ifndef TIMESTAMP_PARSER_H
+#define TIMESTAMP_PARSER_H
+
+#include <string_view>
+#include <cstdint>
+
+// Fixed timestamp layouts understood by TimestampParser.
+enum class TimestampFormat
+{
+    DayMonthYearMinutes, // "dd/MM/yyyy HH:mm" (the onboard logger's default)
+    DayMonthYearSeconds, // "dd/MM/yyyy HH:mm:ss"
+    Iso8601              // "yyyy-MM-ddTHH:mm[:ss[.fff]][Z|+hh:mm|-hh:mm]", 'T' or ' ' as separator
+};
+
+// Converts timestamps of one fixed layout into seconds since 1970-01-01 00:00 UTC using integer
+// arithmetic only. Timestamps without an explicit offset are taken as UTC (logger time).
+// Consecutive rows almost always share a date, so the day number of the last date prefix is
+// cached and only the time of day is decoded for them. Not thread-safe: use one per thread.
+class TimestampParser
+{
+public:
+    explicit TimestampParser(TimestampFormat format = TimestampFormat::DayMonthYearMinutes);
+
+    TimestampFormat format() const { return mFormat; }
+
+    // Parses one cell (surrounding blanks allowed). Returns false and leaves epoch untouched if
+    // the cell does not match the layout or names an impossible date or time.
+    bool parse(std::string_view text, std::int64_t& epoch);
+
+private:
+    bool parseDate(std::string_view date, std::int64_t& day);
+
+    TimestampFormat mFormat;
+    char mCachedDate[10] = {};   // Date prefix of the last successfully parsed cell
+    bool mHasCachedDate = false;
+    std::int64_t mCachedDay = 0; // Days since 1970-01-01 for mCachedDate
+};
+
+#endif // TIMESTAMP_PARSER_H
\ No newline at end of file
@@ -0,0 +1,249 @@
+// vesselProfile.cpp
+#include "vesselProfile.h"
+#include "csvIntoColumns.h"     // Required for skipByteOrderMark
+#include "csvStructuralIndex.h" // Required for forEachCsvCell
+#include <algorithm>   // Required for std::max, std::equal
+#include <cctype>      // Required for std::isspace, std::isdigit, std::tolower
+#include <cstdlib>     // Required for std::strtod
+#include <fstream>     // Required for std::ifstream
+#include <iostream>    // Required for std::cerr, std::endl
+#include <string_view>
+
+namespace {
+
+// Keys of the [columns] section, in LoggerChannel order
+const char* const ChannelKeys[] = { "time", "sog", "stw", "prop_power", "prop_rev", "foc", "rel_wind_dir", "rel_wind_speed" };
+
+static_assert(sizeof(ChannelKeys) / sizeof(ChannelKeys[0]) == static_cast<size_t>(LoggerChannel::Count),
+    "one key per logger channel");
+
+std::string trimmed(std::string_view text)
+{
+    size_t begin = 0;
+    size_t end = text.size();
+    while (begin < end && std::isspace(static_cast<unsigned char>(text[begin]))) {
+        ++begin;
+    }
+    while (end > begin && std::isspace(static_cast<unsigned char>(text[end - 1]))) {
+        --end;
+    }
+    return std::string(text.substr(begin, end - begin));
+}
+
+bool equalsIgnoringCase(std::string_view a, std::string_view b)
+{
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+        return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y));
+    });
+}
+
+// Channels the plots can do without; "none" maps them to no column
+bool isOptional(size_t channel)
+{
+    return channel == static_cast<size_t>(LoggerChannel::PropRev);
+}
+
+bool isNone(const std::string& column)
+{
+    return equalsIgnoringCase(column, "none");
+}
+
+// 1-based column number, or 0 if text is a header name
+size_t columnNumber(const std::string& text)
+{
+    if (text.empty() || text.size() > 6 || !std::all_of(text.begin(), text.end(), [](char c) { return std::isdigit(static_cast<unsigned char>(c)); })) {
+        return 0;
+    }
+    return std::stoul(text);
+}
+
+// Looks up value in a unit table; false if it's not one of them
+bool unitFactor(const std::string& value, std::initializer_list<std::pair<const char*, double>> units, double& factor)
+{
+    for (const auto& unit : units) {
+        if (equalsIgnoringCase(value, unit.first)) {
+            factor = unit.second;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool setGeneralKey(const std::string& key, const std::string& value, VesselProfile& profile)
+{
+    if (key == "name") {
+        profile.name = value;
+        return true;
+    }
+    if (key == "mcr") {
+        char* end = nullptr;
+        profile.mcr = std::strtod(value.c_str(), &end);
+        return end != value.c_str() && *end == '\0' && profile.mcr > 0.0;
+    }
+    if (key == "delimiter") {
+        if (equalsIgnoringCase(value, "tab")) {
+            profile.delimiter = '\t';
+            return true;
+        }
+        profile.delimiter = value.empty() ? '\0' : value[0];
+        return value.size() == 1 && value[0] != '"';
+    }
+    if (key == "timestamp_format") {
+        if (value == "dd/MM/yyyy HH:mm") {
+            profile.timestampFormat = TimestampFormat::DayMonthYearMinutes;
+        }
+        else if (value == "dd/MM/yyyy HH:mm:ss") {
+            profile.timestampFormat = TimestampFormat::DayMonthYearSeconds;
+        }
+        else if (equalsIgnoringCase(value, "iso8601")) {
+            profile.timestampFormat = TimestampFormat::Iso8601;
+        }
+        else {
+            return false;
+        }
+        return true;
+    }
+    if (key == "foc_unit") {
+        return unitFactor(value, { { "t/day", 1.0 }, { "kg/h", 24.0 / 1000.0 } }, profile.focToTonnesPerDay);
+    }
+    if (key == "power_unit") {
+        return unitFactor(value, { { "kW", 1.0 }, { "MW", 1000.0 } }, profile.powerToKilowatts);
+    }
+    if (key == "speed_unit") {
+        return unitFactor(value, { { "kn", 1.0 }, { "m/s", 3600.0 / 1852.0 } }, profile.speedToKnots);
+    }
+    if (key == "wind_speed_unit") {
+        return unitFactor(value, { { "m/s", 1.0 }, { "kn", 1852.0 / 3600.0 } }, profile.windSpeedToMetresPerSecond);
+    }
+    return false;
+}
+
+bool setColumnKey(const std::string& key, const std::string& value, VesselProfile& profile)
+{
+    for (size_t channel = 0; channel < static_cast<size_t>(LoggerChannel::Count); ++channel) {
+        if (key == ChannelKeys[channel]) {
+            profile.columns[channel] = value;
+            return !value.empty() && (!isNone(value) || isOptional(channel));
+        }
+    }
+    return false;
+}
+
+// Cells of the first line of the file (without byte order mark)
+bool readHeader(const std::string& csvFilename, char delimiter, std::vector<std::string>& names)
+{
+    std::ifstream file(csvFilename, std::ios::binary);
+    std::string line;
+    if (!file || !std::getline(file, line)) {
+        return false;
+    }
+    std::string_view text(line);
+    text.remove_prefix(skipByteOrderMark(text));
+    forEachCsvCell(text, delimiter,
+        [&names](size_t, std::string_view cell) { names.push_back(trimmed(cell)); },
+        [](size_t) {});
+    return true;
+}
+
+} // namespace
+
+const size_t ColumnLayout::NotLogged;
+
+bool loadVesselProfile(const std::string& filename, VesselProfile& profile)
+{
+    std::ifstream file(filename);
+    if (!file) {
+        std::cerr << "Error: Cannot open vessel profile " << filename << std::endl;
+        return false;
+    }
+
+    bool inColumns = false;
+    std::string line;
+    for (size_t lineNumber = 1; std::getline(file, line); ++lineNumber) {
+        const std::string text = trimmed(line);
+        if (text.empty() || text[0] == '#') {
+            continue;
+        }
+        if (text.front() == '[' && text.back() == ']') {
+            const std::string section = trimmed(std::string_view(text).substr(1, text.size() - 2));
+            inColumns = section == "columns";
+            if (!inColumns) {
+                std::cerr << "Error: " << filename << ":" << lineNumber << ": unknown section [" << section << "]" << std::endl;
+                return false;
+            }
+            continue;
+        }
+
+        const size_t equals = text.find('=');
+        const std::string key = equals == std::string::npos ? text : trimmed(std::string_view(text).substr(0, equals));
+        const std::string value = equals == std::string::npos ? std::string() : trimmed(std::string_view(text).substr(equals + 1));
+        const bool valid = equals != std::string::npos
+            && (inColumns ? setColumnKey(key, value, profile) : setGeneralKey(key, value, profile));
+        if (!valid) {
+            std::cerr << "Error: " << filename << ":" << lineNumber << ": invalid line '" << text << "'" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool resolveColumnLayout(const VesselProfile& profile, const std::string& csvFilename, ColumnLayout& layout)
+{
+    const size_t channelCount = static_cast<size_t>(LoggerChannel::Count);
+    std::vector<std::string> header;
+    layout.headerLines = 0;
+    for (const std::string& column : profile.columns) {
+        if (columnNumber(column) == 0 && !isNone(column)) {
+            if (!readHeader(csvFilename, profile.delimiter, header)) {
+                std::cerr << "Error: Cannot read the header line of " << csvFilename << std::endl;
+                return false;
+            }
+            layout.headerLines = 1;
+            break;
+        }
+    }
+
+    layout.channelColumns.assign(channelCount, 0);
+    for (size_t channel = 0; channel < channelCount; ++channel) {
+        const std::string& column = profile.columns[channel];
+        const size_t number = columnNumber(column);
+        if (isNone(column)) {
+            layout.channelColumns[channel] = ColumnLayout::NotLogged;
+            continue;
+        }
+        if (number > 0) {
+            layout.channelColumns[channel] = number - 1;
+            continue;
+        }
+        const auto found = std::find_if(header.begin(), header.end(),
+            [&column](const std::string& name) { return equalsIgnoringCase(name, column); });
+        if (found == header.end()) {
+            std::cerr << "Error: " << csvFilename << " has no column '" << column << "' (for "
+                << ChannelKeys[channel] << ")" << std::endl;
+            return false;
+        }
+        layout.channelColumns[channel] = static_cast<size_t>(found - header.begin());
+    }
+
+    // Only the mapped columns are stored; the tokenizer doesn't convert the rest, nor look at
+    // anything past the last mapped column
+    size_t columnCount = 0;
+    for (size_t column : layout.channelColumns) {
+        if (column != ColumnLayout::NotLogged) {
+            columnCount = std::max(columnCount, column + 1);
+        }
+    }
+    layout.schema.assign(columnCount, ColumnType::Skip);
+    for (size_t channel = 0; channel < channelCount; ++channel) {
+        if (layout.channelColumns[channel] == ColumnLayout::NotLogged) {
+            continue;
+        }
+        layout.schema[layout.channelColumns[channel]] =
+            channel == static_cast<size_t>(LoggerChannel::Time) ? ColumnType::Timestamp : ColumnType::Numeric;
+    }
+    if (layout.schema[layout.channelColumns[static_cast<size_t>(LoggerChannel::Time)]] != ColumnType::Timestamp) {
+        std::cerr << "Error: The time column of " << csvFilename << " is also mapped to another channel" << std::endl;
+        return false;
+    }
+    return true;
+}
\ No newline at end of file
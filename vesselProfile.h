@@ -0,0 +1,84 @@
+// vesselProfile.h
+#ifndef VESSEL_PROFILE_H
+#define VESSEL_PROFILE_H
+
+#include <string>
+#include <vector>
+#include "csvToTypedColumns.h"
+
+// Logger channels the plots are built from; a profile says in which CSV column each one is.
+enum class LoggerChannel
+{
+    Time,
+    Sog,
+    Stw,
+    PropPower,
+    PropRev,
+    Foc,
+    RelWindDir,
+    RelWindSpeed,
+    Count
+};
+
+// What differs from one vessel's logger to the next: engine MCR, units, CSV dialect and which
+// column holds which channel. Read from a small text file:
+//
+//   # Lines starting with '#' are comments
+//   name = MV Example
+//   mcr = 9930                         (kW)
+//   delimiter = ,                      (or ;, tab)
+//   timestamp_format = dd/MM/yyyy HH:mm  (or dd/MM/yyyy HH:mm:ss, iso8601)
+//   foc_unit = t/day                   (or kg/h)
+//   power_unit = kW                    (or MW)
+//   speed_unit = kn                    (or m/s)
+//   wind_speed_unit = m/s              (or kn)
+//
+//   [columns]
+//   time = Timestamp                   (header name, or column number counting from 1)
+//   sog = SOG
+//   stw = STW
+//   prop_power = PropPower
+//   prop_rev = PropRev                 (or none, if the logger has no shaft speed)
+//   foc = FOC
+//   rel_wind_dir = RelWindDirDeg
+//   rel_wind_speed = RelWindSpeed
+//
+// Columns given by name make the first line of the file a header; with numbers only there is none.
+// Keys left out keep the defaults below, which describe the original logger (Book1.csv).
+struct VesselProfile
+{
+    std::string name;
+    double mcr = 9930.0; // Maximum continuous rating of the main engine (kW)
+    char delimiter = ',';
+    TimestampFormat timestampFormat = TimestampFormat::DayMonthYearMinutes;
+
+    // Factors from the logger's units to the ones the plots and derived metrics use
+    double focToTonnesPerDay = 1.0;
+    double powerToKilowatts = 1.0;
+    double speedToKnots = 1.0;
+    double windSpeedToMetresPerSecond = 1.0;
+
+    // Per LoggerChannel: header name, or 1-based column number
+    std::vector<std::string> columns = { "1", "2", "3", "4", "5", "6", "10", "11" };
+};
+
+// A profile resolved against one CSV file: the schema to parse it with, in which only the mapped
+// columns are stored (the others are skipped by the tokenizer), and where each channel ended up.
+struct ColumnLayout
+{
+    static const size_t NotLogged = static_cast<size_t>(-1); // Channel mapped to "none"
+
+    std::vector<ColumnType> schema;
+    std::vector<size_t> channelColumns; // Per LoggerChannel: column in the schema and the parsed table, or NotLogged
+    size_t headerLines = 0;             // Leading rows of the file that are not data
+};
+
+// Reads a profile file over the defaults. Returns false, after reporting the problem on
+// std::cerr, if the file can't be read or holds an unknown key or value.
+bool loadVesselProfile(const std::string& filename, VesselProfile& profile);
+
+// Finds the profile's columns in csvFilename (reading its header line if columns are named).
+// Returns false, after reporting the problem on std::cerr, if a column can't be found.
+bool resolveColumnLayout(const VesselProfile& profile, const std::string& csvFilename, ColumnLayout& layout);
+
+#endif // VESSEL_PROFILE_H
\ No newline at end of file